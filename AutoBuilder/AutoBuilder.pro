@@ -14,6 +14,7 @@ DEFINES += AT_RANGE_CHECK
 SOURCES += \
         ../Libs/PugiXml/pugixml.cpp \
         ../Libs/SelfMade/Strings/u_Strings.cpp \
+        ../Unicodia/Uc/UcPack.cpp \
         data.cpp \
         egyptian.cpp \
         entities.cpp \
@@ -22,6 +23,7 @@ SOURCES += \
         library.cpp \
         loader.cpp \
         main.cpp \
+        stats.cpp \
         sutton.cpp \
         textbase.cpp \
         ucdcom.cpp \
@@ -37,6 +39,7 @@ HEADERS += \
     ../Libs/SelfMade/u_Vector.h \
     ../Unicodia/Uc/UcCp.h \
     ../Unicodia/Uc/UcFlags.h \
+    ../Unicodia/Uc/UcPack.h \
     data.h \
     egyptian.h \
     entities.h \
@@ -44,6 +47,7 @@ HEADERS += \
     legacy.h \
     library.h \
     loader.h \
+    stats.h \
     sutton.h \
     textbase.h \
     ucdcom.h \
@@ -1,8 +1,11 @@
 // C++
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <charconv>
+#include <algorithm>
 #include <deque>
+#include <span>
 #include <unordered_set>
 
 // PugiXML
@@ -14,6 +17,7 @@
 
 // Unicode
 #include "UcCp.h"
+#include "UcPack.h"
 
 // Project-local
 #include "ucdcom.h"
@@ -23,6 +27,7 @@
 #include "legacy.h"
 #include "library.h"
 #include "loader.h"
+#include "stats.h"
 #include "sutton.h"
 #include "textbase.h"
 #include "unibase.h"
@@ -106,8 +111,10 @@ struct NumCache
 {
     std::deque<Numeric> ord;
     std::map<std::string, const Numeric*> ndx;
+    std::vector<std::vector<int>> cps;      ///< numeric → indexes in cpInfo
 
     const Numeric& parse(std::string_view numType, std::string_view x);
+    void addCp(const Numeric& num, int iCp);
     size_t size() const { return ord.size(); }
 };
 
@@ -123,9 +130,18 @@ const Numeric& NumCache::parse(std::string_view numType, std::string_view x)
     Numeric newNum = parseNumeric(numType, x, ord.size());
     auto& newPlace = ord.emplace_back(newNum);
     ndx[key] = &newPlace;
+    cps.emplace_back();
     return newPlace;
 }
 
+void NumCache::addCp(const Numeric& num, int iCp)
+{
+    // NaN has no reverse index: nobody searches for it
+    if (num.textValue.empty())
+        return;
+    cps.at(num.index).push_back(iCp);
+}
+
     std::string transformVersion(std::string s)
 {
     for (auto& c : s) {
@@ -191,9 +207,10 @@ struct StringData
 {
     std::string s;
     char32_t subj;
-    int offset;
+    int offset;         ///< 1st text of record: record start, where header goes
     uc::TextRole role;
     bool isLast;
+    unsigned char roleMask = 0;     ///< 1st text of record: roles in it, see uc::nameHeaderSize
 };
 
 struct RememberResult
@@ -221,6 +238,7 @@ private:
     M fNdx;
     std::deque<StringData> fInOrder;
     size_t fLength = 0;
+    size_t fRecordStart = 0;    ///< index in fInOrder
     std::set<char32_t> fNonAscii;
 };
 
@@ -264,14 +282,61 @@ RememberResult StringLib::remember(
 
 void StringLib::finishCp()
 {
-    if (!fInOrder.empty()) {
-        auto& bk = fInOrder.back();
-        if (!bk.isLast) {
-            bk.isLast = true;
-            // +1: command CMD_END
-            ++fLength;
-        }
+    if (fRecordStart >= fInOrder.size())
+        return;
+    unsigned mask = 0;
+    for (auto i = fRecordStart; i < fInOrder.size(); ++i)
+        mask |= uc::textRoleBit(fInOrder[i].role);
+    auto headerSize = uc::nameHeaderSize(mask);
+    fInOrder[fRecordStart].roleMask = mask;
+    for (auto i = fRecordStart + 1; i < fInOrder.size(); ++i)
+        fInOrder[i].offset += headerSize;
+    fInOrder.back().isLast = true;
+    // +1: command CMD_END
+    fLength += headerSize + 1;
+    fRecordStart = fInOrder.size();
+}
+
+
+///
+///  Makes name record’s header: role mask, then offsets of 1st texts
+///  @param [in] record  texts of one record
+///
+std::string nameHeader(std::span<const StringData* const> record)
+{
+    auto mask = record[0]->roleMask;
+    std::array<unsigned, uc::N_TEXT_ROLES> offsets {};
+    unsigned pos = uc::nameHeaderSize(mask);
+    for (auto v : record) {
+        auto& place = offsets[static_cast<unsigned>(v->role)];
+        if (place == 0)
+            place = pos;
+        pos += v->s.length() + 2;
+    }
+    if (pos > 0xFFFF)
+        throw std::logic_error("Name record is too long");
+    std::string r;
+    r += static_cast<char>(mask);
+    for (unsigned i = 0; i < uc::N_TEXT_ROLES; ++i) {
+        auto role = static_cast<uc::TextRole>(i);
+        if (role == uc::TextRole::MAIN_NAME || !(mask & uc::textRoleBit(role)))
+            continue;
+        r += static_cast<char>(offsets[i] & 0xFF);
+        r += static_cast<char>(offsets[i] >> 8);
     }
+    return r;
+}
+
+
+void writeHexLiteral(std::ostream& os, std::string_view x)
+{
+    char text[8];
+    os << R"(u8")";
+    for (auto c : x) {
+        snprintf(text, std::size(text), R"(\x%02X)", static_cast<unsigned char>(c));
+        os << text;
+    }
+    os << R"(" )";
 }
 
 
@@ -326,6 +391,42 @@ namespace {
         return true;
     }
 
+    ///
+    ///  Hot columns of cpInfo: one byte per char, see uc::scanColumn
+    ///
+    struct HotColumns {
+        std::vector<std::string> scripts, versions, categories, bidiClasses;
+
+        void write(std::ostream& os) const;
+    };
+
+    void writeColumn(std::ostream& os, std::string_view type, std::string_view alias,
+                     std::string_view name, const std::vector<std::string>& values)
+    {
+        os << "alignas(uc::COLUMN_ALIGN) constinit const uc::" << type
+           << " uc::" << name << "[uc::N_CPS] {\n";
+        for (size_t i = 0; i < values.size(); ++i) {
+            os << alias << "::" << values[i] << ',';
+            if (i % 16 == 15)
+                os << '\n';
+        }
+        os << "};\n";
+    }
+
+    void HotColumns::write(std::ostream& os) const
+    {
+        os << "namespace {\n";
+        os << "    using Sc = uc::EcScript;\n";
+        os << "    using Vr = uc::EcVersion;\n";
+        os << "    using Ca = uc::EcCategory;\n";
+        os << "    using Bi = uc::EcBidiClass;\n";
+        os << "}\n";
+        writeColumn(os, "EcScript", "Sc", "cpScripts", scripts);
+        writeColumn(os, "EcVersion", "Vr", "cpVersions", versions);
+        writeColumn(os, "EcCategory", "Ca", "cpCategories", categories);
+        writeColumn(os, "EcBidiClass", "Bi", "cpBidiClasses", bidiClasses);
+    }
+
 }   // anon namespace
 
 
@@ -447,6 +548,9 @@ int main()
     StringLib strings;
     NumCache nums;
     int nDeprecated = 0, nUpCase = 0, nChars = 0;
+    std::vector<char32_t> cpCodes;      ///< index in cpInfo → code
+    HotColumns hotColumns;
+    stats::Collector cpStats(supportData.blocks);
     NewLine nl;
     std::cout << "Processing main base..." << std::flush;
 
@@ -613,7 +717,8 @@ int main()
            << " }, ";                           // /name
 
         // Char’s type
-        os << "EcCategory::" << transform(cpInfo.generalCat, smCharCat) << ", ";
+        auto sCategory = transform(cpInfo.generalCat, smCharCat);
+        os << "EcCategory::" << sCategory << ", ";
 
         // Char’s version
         auto& sVersion = ages.findRq(cp);
@@ -636,6 +741,11 @@ int main()
         if (sScript == "Hira"sv && sLowerName.starts_with("Hentaigana"))
             sScript = "Hent"sv;
         os << "EcScript::" << sScript << ", ";
+        cpStats.addCp(cp, sVersion, sScript, sCategory, sBidiClass);
+        hotColumns.scripts.emplace_back(sScript);
+        hotColumns.versions.push_back("V_" + transformVersion(sVersion));
+        hotColumns.categories.emplace_back(sCategory);
+        hotColumns.bidiClasses.push_back("z_" + std::string{sBidiClass});
 
         if (cpInfo.upperCase != 0) {
             ++nUpCase;
@@ -650,6 +760,7 @@ int main()
         //    • Nu — number
         // nv = Nan / whole number / vulgar fraction
         auto& numPlace = nums.parse(cpInfo.numeric.type->id, cpInfo.numeric.value);
+        nums.addCp(numPlace, nChars);
         os << numPlace.index << ", ";
 
         if (flags) {
@@ -661,6 +772,7 @@ int main()
         os << ", {" << cpInfo.kx.radical << "," << cpInfo.kx.plusStrokes << "}";
 
         os << "}," << '\n';
+        cpCodes.push_back(cp);
         ++nChars;
 
         strings.finishCp();
@@ -673,18 +785,46 @@ int main()
               << nUpCase << " to-up-case, "
               << nDeprecated << " deprecated." << '\n';
 
+    os << "#ifndef UC_PACK_ONLY" "\n";
     os << "const char8_t uc::allStrings[] = \n";
     char text[40];
-    for (auto& v : strings.inOrder()) {
+    auto& inOrder = strings.inOrder();
+    std::string stringBytes;    ///< allStrings for data pack
+    std::vector<const StringData*> record;
+    for (size_t i = 0; i < inOrder.size(); ++i) {
+        auto& v = inOrder[i];
+        if (record.empty()) {
+            for (auto j = i; ; ++j) {
+                record.push_back(&inOrder[j]);
+                if (inOrder[j].isLast)
+                    break;
+            }
+            auto header = nameHeader(record);
+            writeHexLiteral(os, header);
+            stringBytes += header;
+        }
+        if (v.isLast)
+            record.clear();
         snprintf(text, std::size(text), R"(u8"\x%02X\x%02X" ")",
                  static_cast<unsigned>(v.role),
                  static_cast<unsigned>(v.s.length()));
         os << text << encodeC(v.s) << R"("  )";
-        if (v.isLast)
+        stringBytes += static_cast<char>(v.role);
+        stringBytes += static_cast<char>(v.s.length());
+        stringBytes += v.s;
+        if (v.isLast) {
             os << R"("\0")";
+            stringBytes += '\0';
+        }
         os << "  // " << std::hex << static_cast<int>(v.subj) << '\n';
     }
     os << ";\n";
+    os << "#endif" "\n";
+    stringBytes += '\0';   // of string literal
+
+    uc::pack::Builder pack;
+    pack.add(uc::pack::SecId::STRINGS,
+             { reinterpret_cast<const unsigned char*>(stringBytes.data()), stringBytes.size() });
 
     ///// Numerics /////////////////////////////////////////////////////////////
 
@@ -703,6 +843,97 @@ int main()
     }
     os << "};\n";
 
+    // Reverse index: numeric → chars
+    size_t nNumericCps = 0;
+    os << "const unsigned uc::numericCpStarts[uc::N_NUMERICS + 1] { ";
+    for (auto& v : nums.cps) {
+        os << nNumericCps << ", ";
+        nNumericCps += v.size();
+    }
+    os << nNumericCps << " };\n";
+    os << "const unsigned uc::numericCps[uc::N_NUMERIC_CPS] {\n";
+    for (size_t i = 0; i < nums.cps.size(); ++i) {
+        auto& v = nums.cps[i];
+        if (v.empty())
+            continue;
+        for (auto iCp : v)
+            os << iCp << ",";
+        os << "  // " << i << '\n';
+    }
+    os << "};\n";
+
+    // Lookup: value → numeric, sorted by value
+    // altInt goes as integer, NaN and zero altInt are never searched for
+    struct NumericKey {
+        long long num, denom;
+        size_t index;
+        auto operator <=> (const NumericKey&) const = default;
+    };
+    std::vector<NumericKey> numericKeys;
+    for (const auto& v : nums.ord) {
+        if (v.textValue.empty())
+            continue;
+        numericKeys.push_back({ v.num, v.denom, v.index });
+        if (v.altInt != 0)
+            numericKeys.push_back({ v.altInt, 1, v.index });
+    }
+    std::sort(numericKeys.begin(), numericKeys.end());
+    os << "const uc::NumericKey uc::numericKeys[uc::N_NUMERIC_KEYS] {\n";
+    for (auto& v : numericKeys) {
+        os << "{ " << std::dec << v.num << ", " << v.denom << ", " << v.index << " },\n";
+    }
+    os << "};\n";
+
+    ///// Hot columns //////////////////////////////////////////////////////////
+
+    hotColumns.write(os);
+
+    ///// Code point lookup ////////////////////////////////////////////////////
+
+    // Page # by code / CP_PAGE, then index in cpInfo + 1, 0 = none.
+    // Empty pages are all page 0 → ≈1 MB instead of 8.9 MB of pointers
+    static constexpr char32_t CP_PAGE = 256;
+    static constexpr char32_t CAPACITY = 65536 * 17;
+    using CpPage = std::array<unsigned, CP_PAGE>;
+    std::vector<CpPage> cpPages(1, CpPage{});
+    std::vector<unsigned> cpPageIndex(CAPACITY / CP_PAGE, 0);
+    for (size_t i = 0; i < cpCodes.size(); ++i) {
+        auto code = cpCodes[i];
+        auto& iPage = cpPageIndex.at(code / CP_PAGE);
+        if (iPage == 0) {
+            iPage = cpPages.size();
+            cpPages.emplace_back();
+        }
+        cpPages[iPage][code % CP_PAGE] = i + 1;
+    }
+    if (cpPages.size() > 65535)
+        throw std::logic_error("Too many code point pages, widen cpPageIndex!");
+
+    os << "constinit const unsigned short uc::cpPageIndex[uc::CAPACITY / uc::CP_PAGE] {\n";
+    for (size_t i = 0; i < cpPageIndex.size(); i += 32) {
+        for (size_t j = i; j < i + 32; ++j)
+            os << std::dec << cpPageIndex[j] << ",";
+        os << "  // " << std::hex << i * CP_PAGE << '\n';
+    }
+    os << "};\n";
+    os << "constinit const unsigned uc::cpPages[][uc::CP_PAGE] {\n";
+    for (auto& page : cpPages) {
+        os << "{\n";
+        for (size_t i = 0; i < CP_PAGE; i += 16) {
+            for (size_t j = i; j < i + 16; ++j)
+                os << std::dec << page[j] << ",";
+            os << '\n';
+        }
+        os << "},\n";
+    }
+    os << "};\n";
+    std::cout << "  Made " << std::dec << cpPages.size() << " code point pages." << '\n';
+
+    ///// Stats of chars ///////////////////////////////////////////////////////
+
+    // Blocks, scripts, categories, versions: completeData does not count them
+    cpStats.write(os);
+
     ///// Close main file //////////////////////////////////////////////////////
 
     os.close();
@@ -756,6 +987,26 @@ int main()
     std::cout << "OK, " << oldr.nCps << " CPs, "
                         << oldr.nSpans << " spans." "\n";
 
+    ///// Sutton SignWriting ///////////////////////////////////////////////////
+
+    std::cout << "Processing Sutton base..." << std::flush;
+    auto swr = sw::process();
+    std::cout << "OK, " << swr.nLines << " lines, first inequal "
+              << std::hex << static_cast<uint32_t>(swr.firstInequal) << '\n';
+    pack.add(uc::pack::SecId::SUTTON,
+             { reinterpret_cast<const unsigned char*>(swr.data), sizeof(swr.data) });
+
+    ///// Data pack ////////////////////////////////////////////////////////////
+
+    std::cout << "Writing data pack..." << std::flush;
+    auto packStamp = pack.stamp();
+    {
+        auto packData = pack.build();
+        std::ofstream osPack(uc::pack::FNAME, std::ios::binary);
+        osPack.write(reinterpret_cast<const char*>(packData.data()), packData.size());
+        std::cout << "OK, " << std::dec << packData.size() << " bytes." << '\n';
+    }
+
     ///// Write UcAutoCount ////////////////////////////////////////////////////
 
     os.open("UcAutoCount.h");
@@ -767,8 +1018,11 @@ int main()
     os << "constexpr int N_CPS = " << std::dec << nChars << ";\n";
     os << "constexpr int N_BLOCKS = " << std::dec << supportData.nBlocks << ";\n";
     os << "constexpr int N_NUMERICS = " << std::dec << nums.size() << ";\n";
+    os << "constexpr int N_NUMERIC_CPS = " << std::dec << nNumericCps << ";\n";
+    os << "constexpr int N_NUMERIC_KEYS = " << std::dec << numericKeys.size() << ";\n";
     os << "constexpr unsigned LONGEST_LIB = " << std::dec << longest << ";  // in codepoints" "\n";
     os << "constexpr unsigned N_OLDCOMP_SPANS = " << std::dec << oldr.nSpans << ";\n";
+    os << "constexpr unsigned long long PACK_STAMP = 0x" << std::hex << packStamp << "ull;  // see UcPack.h" "\n";
     os << "}\n";
     os.close();
 
@@ -790,13 +1044,6 @@ int main()
     }
     os.close();
 
-    ///// Sutton SignWriting ///////////////////////////////////////////////////
-
-    std::cout << "Processing Sutton base..." << std::flush;
-    auto swr = sw::process();
-    std::cout << "OK, " << swr.nLines << " lines, first inequal "
-              << std::hex << static_cast<uint32_t>(swr.firstInequal) << '\n';
-
     ///// Forgotten CPs ////////////////////////////////////////////////////////
 
     static constinit const char* FNAME_FORGET = "forget.log";
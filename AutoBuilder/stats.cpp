@@ -0,0 +1,161 @@
+#include "stats.h"
+
+// C++
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+stats::Version stats::Version::parse(std::string_view x)
+{
+    Version r;
+    unsigned major = 0, minor = 0;
+    auto end = x.data() + x.size();
+    auto [p, ec] = std::from_chars(x.data(), end, major);
+    if (ec != std::errc() || p == end || *p != '.'
+            || std::from_chars(p + 1, end, minor).ec != std::errc())
+        throw std::logic_error("Bad Unicode version: " + std::string{x});
+    r.key = major * 100 + minor;
+    r.name = std::to_string(major) + '_' + std::to_string(minor);
+    return r;
+}
+
+
+size_t stats::Collector::findBlock(char32_t cp) const
+{
+    auto it = std::upper_bound(blockRanges.begin(), blockRanges.end(), cp,
+            [](char32_t x, const ucd::BlockRange& y) { return (x < y.start); });
+    if (it == blockRanges.begin() || cp > (--it)->end)
+        throw std::logic_error("Char w/o block");
+    return it - blockRanges.begin();
+}
+
+
+void stats::Collector::addCp(
+        char32_t cp, std::string_view version, std::string_view script,
+        std::string_view category, std::string_view bidiClass)
+{
+    auto ver = Version::parse(version);
+    unsigned iCp = chars.size();
+
+    // Block
+    auto& block = blocks[findBlock(cp)];
+    if (block.nChars == 0) {
+        block.iFirst = iCp;
+        block.version = ver;
+        block.lastVersion = ver;
+    } else {
+        block.version = std::min(block.version, ver);
+        block.lastVersion = std::max(block.lastVersion, ver);
+    }
+    block.iLast = iCp;
+    ++block.nChars;
+
+    // Script
+    auto itScript = scripts.find(script);
+    if (itScript == scripts.end()) {
+        itScript = scripts.emplace(std::string{script}, Script{}).first;
+        itScript->second.plane = cp >> 16;
+        itScript->second.version = ver;
+    } else {
+        itScript->second.version = std::min(itScript->second.version, ver);
+    }
+    ++itScript->second.nChars;
+
+    // Category, bidi class
+    ++categories[std::string{category}];
+    ++bidiClasses[std::string{bidiClass}];
+
+    chars.push_back({ std::move(ver), &itScript->first, category == "FORMAT" });
+}
+
+
+void stats::Collector::writeBlocksByCode16(std::ostream& os) const
+{
+    std::vector<int> r(0x110000 >> 4, -1);
+    for (size_t i = 0; i < blockRanges.size(); ++i) {
+        auto& range = blockRanges[i];
+        for (auto i16 = range.start >> 4; i16 <= (range.end >> 4); ++i16)
+            r.at(i16) = i;
+    }
+    os << "constinit const short uc::blocksByCode16[uc::CAPACITY >> 4] {\n";
+    for (size_t i = 0; i < r.size(); i += 32) {
+        for (size_t j = i; j < i + 32; ++j)
+            os << std::dec << r[j] << ",";
+        os << "  // " << std::hex << (i << 4) << '\n';
+    }
+    os << "};\n";
+}
+
+
+void stats::Collector::writeVersions(std::ostream& os) const
+{
+    struct Nw {
+        unsigned nHani = 0, nNewScripts = 0, nExistingScripts = 0, nFormat = 0, nSymbols = 0;
+    };
+    std::map<Version, Nw> r;
+    for (auto& c : chars) {
+        auto& nw = r[c.version];
+        auto& script = *c.script;
+        if (script == "Hani") {
+            ++nw.nHani;
+        } else if (script == "Zyyy" || script == "Zinh") {
+            ++(c.isFormat ? nw.nFormat : nw.nSymbols);
+        } else if (scripts.find(script)->second.version == c.version) {
+            ++nw.nNewScripts;
+        } else {
+            ++nw.nExistingScripts;
+        }
+    }
+    os << "constinit const uc::VersionStats versionStats0[] {\n";
+    for (auto& [ver, nw] : r) {
+        os << "{ uc::EcVersion::V_" << ver.name << std::dec
+           << ", " << nw.nHani << ", " << nw.nNewScripts << ", " << nw.nExistingScripts
+           << ", " << nw.nFormat << ", " << nw.nSymbols << " },\n";
+    }
+    os << "};\n";
+}
+
+
+void stats::Collector::write(std::ostream& os)
+{
+    // Coptic is 4.1 (script of those characters was Greek)
+    if (auto it = scripts.find("Copt"); it != scripts.end())
+        it->second.version = Version::parse("4.1");
+
+    writeBlocksByCode16(os);
+
+    os << "constinit const uc::BlockStats uc::blockStats[uc::N_BLOCKS] {\n";
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        auto& v = blocks[i];
+        if (v.nChars == 0)
+            throw std::logic_error("Block w/o chars leaked into data!");
+        os << "{ " << std::dec << v.iFirst << ", " << v.iLast << ", " << v.nChars
+           << ", EcVersion::V_" << v.version.name
+           << ", EcVersion::V_" << v.lastVersion.name
+           << " },  // " << std::hex << int(blockRanges[i].start) << '\n';
+    }
+    os << "};\n";
+
+    os << "namespace {\n";
+    os << "constinit const uc::ScriptStats scriptStats0[] {\n";
+    for (auto& [name, v] : scripts) {
+        os << "{ uc::EcScript::" << name << ", " << std::dec << v.nChars << ", " << v.plane
+           << ", uc::EcVersion::V_" << v.version.name << " },\n";
+    }
+    os << "};\n";
+    os << "constinit const uc::CategoryStats categoryStats0[] {\n";
+    for (auto& [name, n] : categories)
+        os << "{ uc::EcCategory::" << name << ", " << std::dec << n << " },\n";
+    os << "};\n";
+    os << "constinit const uc::BidiClassStats bidiClassStats0[] {\n";
+    for (auto& [name, n] : bidiClasses)
+        os << "{ uc::EcBidiClass::z_" << name << ", " << std::dec << n << " },\n";
+    os << "};\n";
+    writeVersions(os);
+    os << "}   // anon namespace\n";
+
+    os << "constinit const std::span<const uc::ScriptStats> uc::scriptStats { scriptStats0 };\n";
+    os << "constinit const std::span<const uc::CategoryStats> uc::categoryStats { categoryStats0 };\n";
+    os << "constinit const std::span<const uc::BidiClassStats> uc::bidiClassStats { bidiClassStats0 };\n";
+    os << "constinit const std::span<const uc::VersionStats> uc::versionStats { versionStats0 };\n";
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+///
+/// Stats of chars (by block, script, category, version…)
+/// that Unicodia used to count on every launch
+///
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "unibase.h"
+
+namespace stats {
+
+    ///  Unicode version, ordered: "15.0" → 1500
+    struct Version {
+        unsigned key = 0;
+        std::string name;   ///< as in EcVersion::V_…
+
+        static Version parse(std::string_view x);
+        std::strong_ordering operator <=> (const Version& x) const { return key <=> x.key; }
+        bool operator == (const Version& x) const { return key == x.key; }
+    };
+
+    class Collector
+    {
+    public:
+        explicit Collector(const std::vector<ucd::BlockRange>& aBlocks)
+            : blockRanges(aBlocks), blocks(aBlocks.size()) {}
+
+        /// Call in cpInfo order
+        /// @param [in] script, category, bidiClass  as in EcScript::…, EcCategory::…,
+        ///                                          EcBidiClass::z_…
+        void addCp(char32_t cp, std::string_view version, std::string_view script,
+                   std::string_view category, std::string_view bidiClass);
+
+        /// Writes tables to UcAuto.cpp
+        /// @throw logic_error  some block has no chars
+        void write(std::ostream& os);
+    private:
+        struct Block {
+            unsigned iFirst = 0, iLast = 0, nChars = 0;
+            Version version, lastVersion;
+        };
+        struct Script {
+            unsigned nChars = 0;
+            int plane = 0;
+            Version version;
+        };
+        struct Char {
+            Version version;
+            const std::string* script;  ///< key in scripts
+            bool isFormat;
+        };
+
+        const std::vector<ucd::BlockRange>& blockRanges;
+        std::vector<Block> blocks;
+        std::map<std::string, Script, std::less<>> scripts;
+        std::map<std::string, unsigned, std::less<>> categories, bidiClasses;
+        std::vector<Char> chars;
+
+        size_t findBlock(char32_t cp) const;
+        void writeBlocksByCode16(std::ostream& os) const;
+        void writeVersions(std::ostream& os) const;
+    };
+
+}   // namespace stats
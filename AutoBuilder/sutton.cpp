@@ -252,6 +252,7 @@ sw::Result sw::process()
     std::ofstream os("UcAutoSutton.cpp");
     os << "// Automatically generated, do not edit!" "\n";
     os << R"(#include "UcFlags.h")" "\n";
+    os << "#ifndef UC_PACK_ONLY" "\n";
     os << "constinit const sw::Char sw::data[sw::CLEN] = {" "\n";
 
     for (int i = 0; i < sw::CLEN; ++i) {
@@ -262,13 +263,18 @@ sw::Result sw::process()
         if (it != minSpecialRotation.end()) {
             minSpecFill = it->second - 1;
         }
-        os << "{.rot=" << d.usedRotations()
-           << ",.fill=" << int(d.usedFills())
-           << ",.minSpecialFill=" << minSpecFill
+        auto& q = r.data[i];
+        q.rot = d.usedRotations();
+        q.fill = d.usedFills();
+        q.minSpecialFill = minSpecFill;
+        os << "{.rot=" << q.rot
+           << ",.fill=" << int(q.fill)
+           << ",.minSpecialFill=" << int(q.minSpecialFill)
            << "},  // " << std::hex << (i + sw::CMIN) << std::dec << '\n';
     }
 
     os << "};" "\n";
+    os << "#endif" "\n";
 
     return r;
 }
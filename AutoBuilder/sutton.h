@@ -2,11 +2,15 @@
 
 #include <unordered_map>
 
+// Unicode
+#include "UcFlags.h"
+
 namespace sw {
 
     struct Result {
         int nLines = 0;
         char32_t firstInequal = 0;
+        sw::Char data[sw::CLEN];    ///< what’s written, for data pack
     };
 
     Result process();
@@ -40,9 +40,9 @@ namespace {
         return (pos != std::string_view::npos);
     }
 
-    unsigned loadBlocks()
+    std::vector<ucd::BlockRange> loadBlocks()
     {
-        unsigned r = 0;
+        std::vector<ucd::BlockRange> r;
         std::ifstream is(UCD_BLOCKS);
         std::string line;
         while (std::getline(is, line)) {
@@ -58,7 +58,10 @@ namespace {
             if (hasSubstr(name, "Private Use") || hasSubstr(name, "Surrogate"))
                 continue;
 
-            ++r;
+            auto range = str::splitSv(vals.at(0), "..");
+            if (range.size() != 2)
+                throw std::logic_error("Bad block range");
+            r.push_back({ fromHex(range[0]), fromHex(range[1]) });
         }
 
         return r;
@@ -225,7 +228,8 @@ ucd::SupportData ucd::loadSupportData()
 {
     SupportData r;
 
-    r.nBlocks = loadBlocks();
+    r.blocks = loadBlocks();
+    r.nBlocks = r.blocks.size();
     r.hangulLines = loadHangulLines();
     r.hanNumValues = loadHanNumValues();
     r.hanKangxi = loadHanKangxi();
@@ -36,8 +36,13 @@ namespace ucd {
         }
     };
 
+    struct BlockRange {
+        char32_t start, end;
+    };
+
     struct SupportData {
         unsigned nBlocks = 0;
+        std::vector<BlockRange> blocks;     ///< w/o private use and surrogates
         std::vector<HangulLine> hangulLines;
         std::unordered_map<char32_t, Numeric> hanNumValues;
         std::unordered_map<char32_t, Kx> hanKangxi;
@@ -30,6 +30,8 @@ void loc::Dic::dump(size_t maxSize)
 
 const loc::Text& loc::Dic::get(std::string_view id)
 {
+    if (auto it = fMap.find(id); it != fMap.end() && it->second.isFull())
+        return it->second;
     auto& data = fMap[std::string{id}];
     if (!data.isFull()) {
         auto r = str::cat(u8'[', str::toU8sv(id), u8']');
@@ -41,7 +43,7 @@ const loc::Text& loc::Dic::get(std::string_view id)
 
 const loc::Text* loc::Dic::getIf(std::string_view id) const
 {
-    auto it = fMap.find(std::string{id});
+    auto it = fMap.find(id);
     if (it == fMap.end())
         return nullptr;
     return &it->second;
@@ -66,7 +66,11 @@ namespace loc {
         const Text& get(std::string_view id);
         const Text* getIf(std::string_view id) const;
     private:
-        std::unordered_map<std::string, Text> fMap;
+        /// Find by string_view w/o making std::string
+        struct Hash : public std::hash<std::string_view> {
+            using is_transparent = void;
+        };
+        std::unordered_map<std::string, Text, Hash, std::equal_to<>> fMap;
     };
 
     extern Dic dic;
@@ -0,0 +1,115 @@
+// My header
+#include "CompressedBits.h"
+
+// STL
+#include <istream>
+#include <ostream>
+
+
+void CompressedBits::Block::set(unsigned n)
+{
+    if (n >= BITS_PER_BLOCK)
+        return;
+    auto hi = n >> ITEM_HI_SHIFT;
+    auto lo = n & ITEM_LO_MASK;
+    items[hi] |= (ONE << lo);
+}
+
+
+bool CompressedBits::Block::have(unsigned n)
+{
+    if (n >= BITS_PER_BLOCK)
+        return false;
+    auto hi = n >> ITEM_HI_SHIFT;
+    auto lo = n & ITEM_LO_MASK;
+    return items[hi] & (ONE << lo);
+}
+
+
+void CompressedBits::add(unsigned x)
+{
+    auto hi = x >> BLOCK_HI_SHIFT;
+    if (hi >= blocks.size()) {
+        blocks.resize(hi + PREALLOC1);
+    }
+    auto& blk = blocks[hi];
+    if (!blk)
+        blk = std::make_unique<Block>();
+    blk->set(x & BLOCK_LO_MASK);
+}
+
+
+bool CompressedBits::have(unsigned x) const noexcept
+{
+    auto hi = x >> BLOCK_HI_SHIFT;
+    if (hi >= blocks.size())
+        return false;
+    auto& blk = blocks[hi];
+    if (!blk)
+        return false;
+    return blk->have(x & BLOCK_LO_MASK);
+}
+
+
+CompressedBits::CompressedBits(const CompressedBits& x)
+{
+    blocks.resize(x.blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (auto& blk = x.blocks[i])
+            blocks[i] = std::make_unique<Block>(*blk);
+    }
+}
+
+
+namespace {
+
+    template <class T>
+    inline void writeBin(std::ostream& os, const T& x)
+        { os.write(reinterpret_cast<const char*>(&x), sizeof(x)); }
+
+    template <class T>
+    inline bool readBin(std::istream& is, T& x)
+        { return static_cast<bool>(is.read(reinterpret_cast<char*>(&x), sizeof(x))); }
+
+}   // anon namespace
+
+
+void CompressedBits::write(std::ostream& os) const
+{
+    uint32_t nBlocks = std::count_if(blocks.begin(), blocks.end(),
+                                     [](auto& x) { return static_cast<bool>(x); });
+    writeBin(os, nBlocks);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (auto& blk = blocks[i]) {
+            writeBin(os, static_cast<uint32_t>(i));
+            os.write(blk->bytes(), Block::N_BYTES);
+        }
+    }
+}
+
+
+bool CompressedBits::read(std::istream& is)
+{
+    // Unicode is 0…10FFFF
+    static constexpr uint32_t MAX_BLOCKS = 0x110000 / BITS_PER_BLOCK;
+    blocks.clear();
+    uint32_t nBlocks;
+    if (!readBin(is, nBlocks) || nBlocks > MAX_BLOCKS)
+        return false;
+    for (uint32_t i = 0; i < nBlocks; ++i) {
+        uint32_t index;
+        if (!readBin(is, index) || index >= MAX_BLOCKS) {
+            blocks.clear();
+            return false;
+        }
+        if (index >= blocks.size())
+            blocks.resize(index + 1);
+        auto& blk = blocks[index];
+        blk = std::make_unique<Block>();
+        if (!is.read(blk->bytes(), Block::N_BYTES)) {
+            blocks.clear();
+            return false;
+        }
+    }
+    return true;
+}
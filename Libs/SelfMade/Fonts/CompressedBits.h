@@ -0,0 +1,77 @@
+#pragma once
+
+// C++
+#include <bit>
+
+// STL
+#include <algorithm>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+constexpr bool isPowerOfTwo(unsigned x) { return ((x & (x - 1)) == 0); }
+
+enum class TfPlat { W64, UNK };
+#ifdef _WIN64
+    constexpr TfPlat TF_PLAT = TfPlat::W64;
+#else
+    constexpr TfPlat TF_PLAT = TfPlat::UNK;
+#endif
+constexpr bool TF_PLAT_W64 = (TF_PLAT == TfPlat::W64);
+constexpr bool UNTESTED = true;
+
+class CompressedBits
+{
+public:
+    CompressedBits() = default;
+    CompressedBits(CompressedBits&&) noexcept = default;
+    CompressedBits& operator = (CompressedBits&&) noexcept = default;
+    /// Deep copy
+    CompressedBits(const CompressedBits& x);
+    CompressedBits& operator = (const CompressedBits& x)
+        { return (*this = CompressedBits(x)); }
+
+    bool isEmpty() const noexcept { return blocks.empty(); }
+    bool hasSmth() const noexcept { return !isEmpty(); }
+
+    void add(unsigned x);
+    bool have(unsigned x) const noexcept;
+
+    /// Writes allocated blocks, binary
+    void write(std::ostream& os) const;
+    /// @return [+] OK  [-] bad data, object is empty
+    bool read(std::istream& is);
+private:
+    static constexpr unsigned BYTES_PER_ITEM = sizeof(size_t);
+    static constexpr unsigned BITS_PER_ITEM = BYTES_PER_ITEM * 8;
+    static_assert(isPowerOfTwo(BYTES_PER_ITEM));
+    static_assert(TF_PLAT_W64 ? (BITS_PER_ITEM == 64) : UNTESTED);
+
+    static constexpr size_t BITS_PER_BLOCK = 4096;  // 512 bytes per block
+    static constexpr size_t ITEMS_PER_BLOCK = BITS_PER_BLOCK / BITS_PER_ITEM;
+
+    static constexpr unsigned BLOCK_HI_SHIFT = std::countr_zero(BITS_PER_BLOCK);
+    static constexpr unsigned BLOCK_LO_MASK = BITS_PER_BLOCK - 1;
+    // # of blocks to preallocate, plus 1
+    static constexpr unsigned PREALLOC1 = 8;
+
+    static_assert(isPowerOfTwo(BITS_PER_BLOCK));
+    class Block {
+    public:
+        Block() { std::fill_n(items, ITEMS_PER_BLOCK, 0); }
+        void set(unsigned n);
+        bool have(unsigned n);
+        char* bytes() { return reinterpret_cast<char*>(items); }
+        const char* bytes() const { return reinterpret_cast<const char*>(items); }
+        static constexpr size_t N_BYTES = ITEMS_PER_BLOCK * BYTES_PER_ITEM;
+    private:
+        size_t items[ITEMS_PER_BLOCK];
+
+        static constexpr unsigned ITEM_HI_SHIFT = std::countr_zero(BITS_PER_ITEM);
+        static constexpr unsigned ITEM_LO_MASK = BITS_PER_ITEM - 1;
+        static_assert(TF_PLAT_W64 ? (ITEM_HI_SHIFT == 6) : UNTESTED);
+        static_assert(TF_PLAT_W64 ? (ITEM_LO_MASK == 63) : UNTESTED);
+        static constexpr size_t ONE = 1;
+    };
+    std::vector<std::unique_ptr<Block>> blocks;
+};
@@ -5,10 +5,13 @@
 #include "MemFont.h"
 
 // STL
+#include <fstream>
 #include <iostream>
+#include <map>
 
 // Qt
 #include <QApplication>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QFontDatabase>
@@ -31,55 +34,123 @@ inline void msg([[maybe_unused]] Args&&... x)
 }
 
 
-//// CompressedBits ////////////////////////////////////////////////////////////
-
+//// Coverage cache ////////////////////////////////////////////////////////////
+
+
+namespace {
+
+    template <class T>
+    inline void writeBin(std::ostream& os, const T& x)
+        { os.write(reinterpret_cast<const char*>(&x), sizeof(x)); }
+
+    template <class T>
+    inline bool readBin(std::istream& is, T& x)
+        { return static_cast<bool>(is.read(reinterpret_cast<char*>(&x), sizeof(x))); }
+
+    /// Bump when format changes
+    constexpr char COVERAGE_MAGIC[8] { 'F', 'o', 'n', 't', 'C', 'o', 'v', '1' };
+
+    struct Coverage {
+        qint64 size = 0;
+        qint64 mtime = 0;       ///< ms since epoch, UTC
+        CompressedBits cps;
+    };
+
+    struct CoverageCache {
+        std::filesystem::path fname;
+        std::map<QString, Coverage> fonts;  ///< std::map: pointers to cps must stay
+        bool isChanged = false;
+    } coverageCache;
+
+    qint64 mtimeOf(const QFileInfo& fi)
+        { return fi.lastModified().toMSecsSinceEpoch(); }
+
+    void rememberFontCoverage(const QString& fname, const CompressedBits& cps)
+    {
+        // Empty = we did not walk cmap, do not spoil probeMetrics and probeChar
+        if (cps.isEmpty())
+            return;
+        QFileInfo fi(fname);
+        auto [it, isNew] = coverageCache.fonts.try_emplace(fname);
+        auto& v = it->second;
+        auto size = fi.size();
+        auto mtime = mtimeOf(fi);
+        if (!isNew && v.size == size && v.mtime == mtime)
+            return;
+        // Overwrite in place: Font may hold a pointer to cps
+        v.size = size;
+        v.mtime = mtime;
+        v.cps = cps;
+        coverageCache.isChanged = true;
+    }
 
-void CompressedBits::Block::set(unsigned n)
-{
-    if (n >= BITS_PER_BLOCK)
-        return;
-    auto hi = n >> ITEM_HI_SHIFT;
-    auto lo = n & ITEM_LO_MASK;
-    items[hi] |= (ONE << lo);
-}
+}   // anon namespace
 
 
-bool CompressedBits::Block::have(unsigned n)
+void loadFontCoverage(const std::filesystem::path& fname)
 {
-    if (n >= BITS_PER_BLOCK)
-        return false;
-    auto hi = n >> ITEM_HI_SHIFT;
-    auto lo = n & ITEM_LO_MASK;
-    return items[hi] & (ONE << lo);
+    // Fonts installed before that are newer, keep them
+    coverageCache.fname = fname;
+
+    std::ifstream is(fname, std::ios::binary);
+    char magic[sizeof(COVERAGE_MAGIC)];
+    uint32_t bitsPerItem, nFonts;
+    if (!readBin(is, magic)
+            || !std::equal(std::begin(magic), std::end(magic), std::begin(COVERAGE_MAGIC))
+            || !readBin(is, bitsPerItem) || bitsPerItem != sizeof(size_t) * 8
+            || !readBin(is, nFonts))
+        return;
+    for (uint32_t i = 0; i < nFonts; ++i) {
+        uint32_t len;
+        if (!readBin(is, len) || len > 4096)
+            break;
+        std::string path(len, '\0');
+        Coverage v;
+        if (!is.read(path.data(), len) || !readBin(is, v.size) || !readBin(is, v.mtime)
+                || !v.cps.read(is))
+            break;
+        if (v.cps.hasSmth())
+            coverageCache.fonts.try_emplace(QString::fromStdString(path), std::move(v));
+    }
+    msg("Loaded coverage of ", coverageCache.fonts.size(), " fonts");
 }
 
 
-void CompressedBits::add(unsigned x)
+void saveFontCoverage()
 {
-    auto hi = x >> BLOCK_HI_SHIFT;
-    if (hi >= blocks.size()) {
-        blocks.resize(hi + PREALLOC1);
+    if (!coverageCache.isChanged || coverageCache.fname.empty())
+        return;
+    std::ofstream os(coverageCache.fname, std::ios::binary);
+    if (!os.is_open())
+        return;
+    os.write(COVERAGE_MAGIC, sizeof(COVERAGE_MAGIC));
+    writeBin(os, static_cast<uint32_t>(sizeof(size_t) * 8));
+    writeBin(os, static_cast<uint32_t>(coverageCache.fonts.size()));
+    for (auto& [name, v] : coverageCache.fonts) {
+        auto path = name.toStdString();
+        writeBin(os, static_cast<uint32_t>(path.size()));
+        os.write(path.data(), path.size());
+        writeBin(os, v.size);
+        writeBin(os, v.mtime);
+        v.cps.write(os);
     }
-    auto& blk = blocks[hi];
-    if (!blk)
-        blk = std::make_unique<Block>();
-    blk->set(x & BLOCK_LO_MASK);
+    coverageCache.isChanged = false;
 }
 
 
-bool CompressedBits::have(unsigned x) const noexcept
+const CompressedBits* findFontCoverage(const QString& fname)
 {
-    auto hi = x >> BLOCK_HI_SHIFT;
-    if (hi >= blocks.size())
-        return false;
-    auto& blk = blocks[hi];
-    if (!blk)
-        return false;
-    return blk->have(x & BLOCK_LO_MASK);
+    auto it = coverageCache.fonts.find(fname);
+    if (it == coverageCache.fonts.end())
+        return nullptr;
+    QFileInfo fi(fname);
+    auto& v = it->second;
+    if (v.cps.isEmpty() || !fi.exists() || fi.size() != v.size || mtimeOf(fi) != v.mtime)
+        return nullptr;
+    return &v.cps;
 }
 
 
-
 //// TempFont //////////////////////////////////////////////////////////////////
 
 
@@ -110,6 +181,8 @@ TempFont installTempFontFull(
                 mf.dehintGlyph(giDotc);
             }
             r.id = QFontDatabase::addApplicationFontFromData(mf.qdata());
+            if (r.id >= 0)
+                rememberFontCoverage(fname, r.cps);
         } catch (const std::exception& e) {
             std::cout << "ERROR: " << e.what() << '\n';
         }
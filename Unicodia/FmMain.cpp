@@ -74,6 +74,8 @@ using namespace std::string_view_literals;
 namespace {
     // No need custom drawing — solves nothing
     constexpr TableDraw TABLE_DRAW = TableDraw::INTERNAL;
+    /// Search-as-you-type starts when user stops typing for this time, ms
+    constexpr int LIVE_SEARCH_DELAY = 250;
 #define N_CHECKED_VERSIONS "8"
 #define SUBURL_REPO "Mercury13/unicodia/releases"
     constinit const char* URL_UPDATE = "https://api.github.com/repos/" SUBURL_REPO "?per_page=" N_CHECKED_VERSIONS;
@@ -644,9 +646,9 @@ const uc::SearchLine& SearchModel::lineAt(size_t iGroup, size_t iLine) const
     if (iGroup >= groups.size())
         return uc::SearchLine::STUB;
     auto& group = groups.at(iGroup);
-    if (iLine >= group.lines.size())
+    if (iLine >= group.size())
         return uc::SearchLine::STUB;
-    return group.lines[iLine];
+    return group.lineAt(iLine);
 }
 
 
@@ -704,6 +706,73 @@ int SearchModel::rowCount(const QModelIndex& index) const
 }
 
 
+const uc::SearchGroup* SearchModel::groupOf(const QModelIndex& parent) const
+{
+    size_t iGroup;
+    switch (style) {
+    case uc::ReplyStyle::FLAT:
+        if (parent.isValid())
+            return nullptr;
+        iGroup = 0;
+        break;
+    case uc::ReplyStyle::GROUPED:
+        if (!parent.isValid() || parent.internalId() != GROUP)
+            return nullptr;
+        iGroup = parent.row();
+        break;
+    default:
+        __builtin_unreachable();
+    }
+    if (iGroup >= groups.size())
+        return nullptr;
+    return &groups[iGroup];
+}
+
+
+QModelIndex SearchModel::indexOf(const uc::MiniLine& x, size_t maxRows) const
+{
+    size_t nGroups = (style == uc::ReplyStyle::FLAT) ? 1 : groups.size();
+    for (size_t iGroup = 0; iGroup < nGroups; ++iGroup) {
+        if (iGroup >= groups.size())
+            break;
+        // Do not make every line of lazy group
+        auto& group = groups[iGroup];
+        auto n = std::min(group.size(), std::max(group.lines.size(), maxRows));
+        for (size_t iLine = 0; iLine < n; ++iLine) {
+            auto& line = lineAt(iGroup, iLine);
+            if (line.type == x.type && line.code == x.code && line.node == x.node)
+                return createIndex(iLine, 0,
+                        (style == uc::ReplyStyle::FLAT) ? ZERO : iGroup);
+        }
+    }
+    return {};
+}
+
+
+bool SearchModel::canFetchMore(const QModelIndex& parent) const
+{
+    auto group = groupOf(parent);
+    return group && group->canFetchMore();
+}
+
+
+void SearchModel::fetchMore(const QModelIndex& parent)
+{
+    auto group = groupOf(parent);
+    if (!group || !group->canFetchMore())
+        return;
+    // Rows are counted after beginInsertRows only
+    auto oldSize = group->size();
+    if (auto n = group->lazy->prefetch()) {
+        beginInsertRows(parent, oldSize, oldSize + n - 1);
+        group->lazy->acceptFetched();
+        endInsertRows();
+    } else {
+        group->lazy->acceptFetched();
+    }
+}
+
+
 QModelIndex SearchModel::index(int row, int column, const QModelIndex& parent) const
 {
     switch (style) {
@@ -804,7 +873,7 @@ namespace {
     QString toNumeric(const uc::SearchLine& line)
     {
         if (line.code < uc::CAPACITY) {
-            if (auto& cp = uc::cpsByCode[line.code]) {
+            if (auto cp = uc::cpsByCode[line.code]) {
                 if (auto& num = cp->numeric(); num.isPresent()) {
                     QString r = loc::get(uc::numTypeInfo[num.ecType].searchLocKey);
                     r += ' ';
@@ -1284,6 +1353,12 @@ FmMain::InitBlocks FmMain::initBlocks()
     ui->treeSearch->setModel(&searchModel);
     ui->treeSearch->setItemDelegate(&searchModel);
     connect(ui->edSearch, &SearchCombo::searchPressed, this, &This::startSearch);
+    timerLiveSearch.setSingleShot(true);
+    timerLiveSearch.setInterval(LIVE_SEARCH_DELAY);
+    connect(&timerLiveSearch, &QTimer::timeout, this, &This::startLiveSearch);
+    connect(ui->edSearch, &QComboBox::editTextChanged, &timerLiveSearch,
+            qOverload<>(&QTimer::start));
+    connect(&searchExecutor, &uc::SearchExecutor::finished, this, &This::searchFinished);
     connect(ui->edSearch, &SearchCombo::focusIn, this, &This::focusSearch);
     connect(ui->treeSearch, &SearchTree::enterPressed, this, &This::searchEnterPressed);
 
@@ -2018,6 +2093,12 @@ void FmMain::openSearch()
 }
 
 
+bool FmMain::isBlocksShown() const
+{
+    return (ui->tabsMain->currentWidget() == ui->tabBlocks);
+}
+
+
 void FmMain::closeSearch()
 {
     if (ui->stackSearch->currentWidget() == ui->pageSearch)
@@ -2026,10 +2107,37 @@ void FmMain::closeSearch()
 
 
 void FmMain::startSearch()
+{
+    timerLiveSearch.stop();
+    searchExecutor.start(ui->edSearch->currentText(), uc::SearchMode::EXPLICIT);
+}
+
+
+void FmMain::startLiveSearch()
 {
     QString s = ui->edSearch->currentText();
-    if (doSearch(s)) {
-        ui->edSearch->addToHistory();
+    // Another tab → result has nowhere to go
+    if (s.trimmed().isEmpty() || !isBlocksShown()) {
+        searchExecutor.cancel();
+        return;
+    }
+    searchExecutor.start(s, uc::SearchMode::LIVE);
+}
+
+
+void FmMain::searchFinished(
+        std::shared_ptr<uc::MultiResult> result, uc::SearchMode mode)
+{
+    switch (mode) {
+    case uc::SearchMode::EXPLICIT:
+        if (result->hasSmth()) {
+            ui->edSearch->addToHistory();
+        }
+        showSearchResult(std::move(*result));
+        break;
+    case uc::SearchMode::LIVE:
+        showLiveSearchResult(std::move(*result));
+        break;
     }
 }
 
@@ -2053,6 +2161,7 @@ void FmMain::showSearchResult(uc::MultiResult&& x)
     case uc::SearchError::OK: {            
             bool hasSmth = x.hasSmth();
             ui->treeSearch->setFlat(x.style == uc::ReplyStyle::FLAT);
+            showSearchStatus(x);
             searchModel.set(x.style, x.version, x.primaryObj, std::move(x.groups));
             openSearch();
             ui->treeSearch->setFocus();
@@ -2070,12 +2179,48 @@ void FmMain::showSearchResult(uc::MultiResult&& x)
 }
 
 
-bool FmMain::doSearch(const QString& what)
+void FmMain::showSearchStatus(const uc::MultiResult& x)
 {
-    auto results = uc::doSearch(what);
-    auto retValue = results.hasSmth();
-    showSearchResult(std::move(results));
-    return retValue;
+    if (x.isTruncated) {
+        ui->lbSearchStatus->setText(
+                loc::get("Search.Truncated").argQ(uc::MAX_PATTERN_HITS));
+    } else {
+        ui->lbSearchStatus->clear();
+    }
+}
+
+
+void FmMain::showLiveSearchResult(uc::MultiResult&& x)
+{
+    // User went to another tab → do not pull the user out
+    if (x.err == uc::SearchError::NO_SEARCH || !isBlocksShown())
+        return;
+    // Nothing found → old results do not match the text, no blinking
+    if (x.err != uc::SearchError::OK || x.isEmpty()) {
+        searchModel.clear();
+        auto key = (x.err == uc::SearchError::OK)
+                ? uc::searchErrorKeys[uc::SearchError::NOT_FOUND]
+                : uc::searchErrorKeys[x.err];
+        ui->lbSearchStatus->setText(loc::get(key));
+        return;
+    }
+    // Char info → show results in place of it
+    openSearch();
+    // Keep selected line if new results have it, not lower than before
+    std::optional<uc::MiniLine> oldLine;
+    auto oldIndex = ui->treeSearch->currentIndex();
+    if (auto line = searchModel.lineAt(oldIndex))
+        oldLine = *line;
+    ui->treeSearch->setFlat(x.style == uc::ReplyStyle::FLAT);
+    showSearchStatus(x);
+    searchModel.set(x.style, x.version, x.primaryObj, std::move(x.groups));
+    if (oldLine) {
+        if (auto index = searchModel.indexOf(*oldLine, oldIndex.row() + 1);
+                index.isValid()) {
+            ui->treeSearch->setCurrentIndex(index);
+            ui->treeSearch->scrollTo(index);
+        }
+    }
 }
 
 
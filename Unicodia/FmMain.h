@@ -8,6 +8,7 @@
 #include <QAbstractTableModel>
 #include <QStyledItemDelegate>
 #include <QElapsedTimer>
+#include <QTimer>
 
 // My libs
 #include "u_Vector.h"
@@ -30,6 +31,7 @@
 #include "UcData.h"
 
 // Search
+#include "Search/executor.h"
 #include "Search/uc.h"
 
 // L10n
@@ -243,6 +245,8 @@ public:
     QModelIndex parent(const QModelIndex &child) const override;
     QVariant groupData(size_t index, int role) const;
     QVariant data(const QModelIndex& index, int role) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
 
     void set(uc::ReplyStyle st, uc::EcVersion ver, uc::PrimaryObj obj,
              SafeVector<uc::SearchGroup>&& x);
@@ -252,6 +256,12 @@ public:
     size_t groupSizeAt(size_t iGroup) const;
     static bool isGroup(const QModelIndex& index);
     const uc::SearchLine* lineAt(const QModelIndex& index) const;
+    /// @return [+] group whose lines are children of parent
+    const uc::SearchGroup* groupOf(const QModelIndex& parent) const;
+    /// Searches among lines already made, and rows < maxRows
+    ///   (lazy group makes them, that’s where the user was)
+    /// @return  index of the same char/node, invalid if none
+    QModelIndex indexOf(const uc::MiniLine& x, size_t maxRows) const;
 protected:
     void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
 private:
@@ -349,6 +359,8 @@ private:
     CharsModel model;
     BlocksModel blocksModel;
     SearchModel searchModel;
+    uc::SearchExecutor searchExecutor;
+    QTimer timerLiveSearch;
     LangModel langModel;
     LibModel libModel;
     FavsModel favsModel;
@@ -407,9 +419,15 @@ private:
     /// @param [in] initiator   other initiator widget besides table
     void blinkCopied(QAbstractItemView* table, QWidget* initiator);
     void clearSample();
-    bool doSearch(const QString& what);
     void showSearchResult(uc::MultiResult&& x);
+    /// Search-as-you-type: shows results in place of char info,
+    /// w/o grabbing focus, switching tabs or jumping to char;
+    /// nothing found → clears results, reason goes to status
+    void showLiveSearchResult(uc::MultiResult&& x);
+    bool isBlocksShown() const;
     void showSearchError(const QString& text);
+    /// Partial or complete results
+    void showSearchStatus(const uc::MultiResult& x);
     void cjkSetCollapseState(bool x);
     void cjkReflectCollapseState();
     void rebuildBlocks();
@@ -453,6 +471,8 @@ private slots:
     void openSearch();
     void closeSearch();
     void startSearch();
+    void startLiveSearch();
+    void searchFinished(std::shared_ptr<uc::MultiResult> result, uc::SearchMode mode);
     void focusSearch();
     void searchEnterPressed(const QModelIndex& index);
     void languageChanged(int index);
@@ -1168,7 +1168,7 @@ QString mywiki::buildHtml(const uc::BidiClass& x)
     str::append(text, "</p>");
 
     str::append(text, "<p>");
-    appendNoFont(text, x.loc.description);
+    appendNoFont(text, x.locDescription());
     return text;
 }
 
@@ -1190,7 +1190,7 @@ QString mywiki::buildHtml(const uc::Category& x)
     appendStylesheet(text);
     appendHeader(text, x, {}, catQuery(x));
     str::append(text, "<p>");
-    appendNoFont(text, x.loc.description);
+    appendNoFont(text, x.locDescription());
     return text;
 }
 
@@ -1274,7 +1274,7 @@ void mywiki::appendHtml(QString& text, const uc::Script& x, bool isScript)
         if (!x.flags.have(uc::Sfg::NO_LANGS)) {
             sp.sep();
             appendBullet(text, "Prop.Bullet.Langs");
-            auto info = append(text, x.loc.langs, context);
+            auto info = append(text, x.locLangs(), context);
             if (!info.hasNSpeakers && context.lang
                     && !context.lang->flags.have(uc::Langfg::NO_AUTO)) {
                 text += ' ';
@@ -1285,7 +1285,7 @@ void mywiki::appendHtml(QString& text, const uc::Script& x, bool isScript)
         if (x.time) {
             sp.sep();
             appendBullet(text, "Prop.Bullet.Appear");
-            auto wikiTime = x.time.wikiText(myDatingLoc, x.loc.timeComment);
+            auto wikiTime = x.time.wikiText(myDatingLoc, x.locTimeComment());
             append(text, wikiTime, context);
         }
         if (x.ecLife != uc::EcLangLife::NOMATTER) {
@@ -1312,7 +1312,7 @@ void mywiki::appendHtml(QString& text, const uc::Script& x, bool isScript)
     }
 
     str::append(text, "<p>");
-    append(text, x.loc.description, context);
+    append(text, x.locDescription(), context);
     str::append(text, "</p>");
 }
 
@@ -1356,7 +1356,7 @@ namespace {
 
     template<>
     inline void appendVal(QString& text, const uc::BidiClass& value)
-        { str::append(text, value.loc.shortName); }
+        { str::append(text, value.locShortName()); }
 
     struct FontLink {
         QString family;
@@ -2058,7 +2058,7 @@ QString mywiki::buildHtml(const uc::Cp& cp)
             if (cp.ecCategory == uc::EcCategory::CONTROL) {
                 //  Control char description
                 appendSubhead(text, "Prop.Head.Control");
-                appendWiki(text, blk, uc::categoryInfo[static_cast<int>(uc::EcCategory::CONTROL)].loc.description);
+                appendWiki(text, blk, uc::categoryInfo[static_cast<int>(uc::EcCategory::CONTROL)].locDescription());
             } else if (auto& sc = cp.script(); &sc != uc::scriptInfo) {
                 // Script description
                 appendScriptSubhead(text);
@@ -2066,13 +2066,13 @@ QString mywiki::buildHtml(const uc::Cp& cp)
             } else {
                 // Script description
                 appendBlockSubhead(text);
-                appendWiki(text, blk, blk.loc.description);
+                appendWiki(text, blk, blk.locDescription());
             }
         } else {
             if (blk.hasDescription()) {
                 // Block description
                 appendBlockSubhead(text);
-                appendWiki(text, blk, blk.loc.description);
+                appendWiki(text, blk, blk.locDescription());
             } else if (auto& sc = cp.scriptEx(); &sc != uc::scriptInfo){
                 // Script description
                 appendScriptSubhead(text);
@@ -2153,7 +2153,7 @@ QString mywiki::buildHtml(const uc::Term& x)
     }
 
     str::append(text, "<p>");
-    appendWiki(text, x, x.loc.description);
+    appendWiki(text, x, x.locDescription());
     return text;
 }
 
@@ -2218,7 +2218,7 @@ QString mywiki::buildHtml(const uc::Block& x)
 
     if (x.hasDescription()) {
         str::append(text, "<p>");
-        appendWiki(text, x, x.loc.description);
+        appendWiki(text, x, x.locDescription());
         str::append(text, "</p>");
     } else if (x.ecScript != uc::EcScript::NONE) {
         text += "<p><b>";
@@ -0,0 +1,71 @@
+// My header
+#include "arena.h"
+
+
+void srh::HayArena::extendTo(size_t nIds)
+{
+    const auto nNames = static_cast<uint32_t>(fNames.size());
+    while (iNames.size() <= nIds)
+        iNames.push_back(nNames);
+}
+
+
+void srh::HayArena::add(
+        HayId id, std::u8string_view value, const Comparator& comparator)
+{
+    // IDs before id are over
+    extendTo(id + 1);
+
+    comparator.prepareHaystack(value, tempPrepared);
+    auto& name = fNames.emplace_back();
+    iNames.back() = fNames.size();
+    name.value = value;
+    name.iPrepared = text.size();
+    name.nPrepared = tempPrepared.size();
+    name.isMnemonic = value.starts_with('&');
+    name.isKeyword = (value.find('#') == std::u8string_view::npos);
+    text += tempPrepared;
+
+    // Words are collected as spans: text is not final yet
+    tempWords.clear();
+    splitWords(tempPrepared, tempWords);
+    name.iWord = tempSpans.size();
+    for (auto v : tempWords) {
+        if (!v.empty()) {
+            tempSpans.push_back({
+                .offset = static_cast<uint32_t>(name.iPrepared + (v.data() - tempPrepared.data())),
+                .length = static_cast<uint32_t>(v.length()) });
+        }
+    }
+    name.nWords = tempSpans.size() - name.iWord;
+}
+
+
+void srh::HayArena::finish(size_t nIds)
+{
+    extendTo(nIds);
+    iNames.resize(nIds + 1);
+
+    // Vectorized matcher reads a bit after haystack
+    text.append(MATCHER_PADDING, 0);
+    text.shrink_to_fit();
+    const std::u8string_view sv = text;
+    fWords.clear();
+    fWords.reserve(tempSpans.size());
+    for (auto v : tempSpans)
+        fWords.emplace_back(sv.substr(v.offset, v.length));
+
+    // Free building data
+    tempSpans = {};
+    tempPrepared = {};
+    tempWords = {};
+    fIsFinished = true;
+}
+
+
+std::span<const srh::HayName> srh::HayArena::names(HayId id) const
+{
+    if (id >= nIds())
+        return {};
+    return std::span{ fNames }.subspan(iNames[id], iNames[id + 1] - iNames[id]);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+///
+/// Read-only arena of prepared haystacks
+///
+
+// STL
+#include <cstdint>
+#include <span>
+
+// Libs
+#include "u_Vector.h"
+
+// Search
+#include "engine.h"
+#include "index.h"
+#include "matcher.h"
+
+namespace srh {
+
+    struct HayName {
+        std::u8string_view value;   ///< as is, should live as long as arena
+        uint32_t iWord = 0, nWords = 0;
+        uint32_t iPrepared = 0, nPrepared = 0;
+        bool isMnemonic = false;    ///< [+] starts with &, check as HTML mnemonic
+        bool isKeyword = false;     ///< [+] no #, check by keyword
+
+        /// @return [+] name’s words go to WordIndex
+        bool isIndexed() const { return isMnemonic || isKeyword; }
+    };
+
+    ///
+    ///  Names, prepared by Comparator (uppercased etc.) and split into
+    ///  HayWords (dictionary lookup done) once and for all.
+    ///
+    ///  Usage: add names in ascending ID order, then finish.
+    ///  All names are searched with DefaultComparator::find then,
+    ///  as all comparators differ in prepareHaystack only.
+    ///  Prepared names are followed by MATCHER_PADDING readable bytes.
+    ///
+    class HayArena
+    {
+    public:
+        void add(HayId id, std::u8string_view value, const Comparator& comparator);
+        void finish(size_t nIds);
+
+        /// @return [+] arena was finished
+        bool isFinished() const { return fIsFinished; }
+        size_t nIds() const { return iNames.size() - 1; }
+
+        std::span<const HayName> names(HayId id) const;
+        std::span<const HayWord> words(const HayName& name) const
+            { return std::span{ fWords }.subspan(name.iWord, name.nWords); }
+        std::u8string_view prepared(const HayName& name) const
+            { return std::u8string_view{ text }.substr(name.iPrepared, name.nPrepared); }
+    private:
+        std::u8string text;
+        SafeVector<HayWord> fWords;
+        SafeVector<HayName> fNames;
+        SafeVector<uint32_t> iNames { 0 };      ///< 1st name of ID; +1 terminator
+        bool fIsFinished = false;
+
+        // Building data
+        struct Span { uint32_t offset, length; };
+        SafeVector<Span> tempSpans;
+        std::u8string tempPrepared;
+        SafeVector<std::u8string_view> tempWords;
+
+        void extendTo(size_t nIds);
+    };
+
+}   // namespace srh
@@ -0,0 +1,124 @@
+// My header
+#include "bench.h"
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+// Libs
+#include "u_Vector.h"
+
+
+///// Allocation counter ///////////////////////////////////////////////////////
+
+#ifdef SEARCH_BENCH_ALLOCS
+
+namespace {
+    std::atomic<long long> allocCount = 0;
+}
+
+void* operator new(std::size_t n)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+long long srh::nAllocs() { return allocCount.load(std::memory_order_relaxed); }
+
+#else
+
+long long srh::nAllocs() { return -1; }
+
+#endif
+
+
+///// Stats ////////////////////////////////////////////////////////////////////
+
+
+namespace {
+
+    /// @pre  x is sorted and non-empty
+    template <class T>
+    T nearestRank(const SafeVector<T>& x, unsigned percent)
+    {
+        // rank = ceil(P/100 · N), 1-based
+        size_t rank = (x.size() * percent + 99) / 100;
+        return x[std::clamp<size_t>(rank, 1, x.size()) - 1];
+    }
+
+    void writeJsonString(std::ostream& os, std::string_view x)
+    {
+        os << '"';
+        for (unsigned char c : x) {
+            switch (c) {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            default:
+                if (c < ' ') {
+                    char buf[10];
+                    std::snprintf(buf, std::size(buf), "\\u%04X", c);
+                    os << buf;
+                } else {
+                    os << static_cast<char>(c);   // UTF-8 goes as is
+                }
+            }
+        }
+        os << '"';
+    }
+
+}   // anon namespace
+
+
+srh::BenchSummary srh::summarize(std::span<const BenchSample> samples)
+{
+    BenchSummary r;
+    r.n = samples.size();
+    if (samples.empty())
+        return r;
+    SafeVector<long long> times, allocs;
+    for (auto& v : samples) {
+        times.push_back(v.ns);
+        allocs.push_back(v.nAllocs);
+    }
+    std::sort(times.begin(), times.end());
+    std::sort(allocs.begin(), allocs.end());
+    r.p50 = nearestRank(times, 50);
+    r.p95 = nearestRank(times, 95);
+    r.p99 = nearestRank(times, 99);
+    r.max = times.back();
+    r.nAllocs = (allocs.front() < 0) ? -1 : nearestRank(allocs, 50);
+    r.nResults = samples.back().nResults;
+    return r;
+}
+
+
+void srh::writeJsonLine(std::ostream& os, std::string_view kind,
+                        std::string_view name, const BenchSummary& x)
+{
+    auto us = [](long long ns) { return ns / 1000; };
+    os << "{\"kind\":";
+    writeJsonString(os, kind);
+    os << ",\"name\":";
+    writeJsonString(os, name);
+    os << ",\"n\":" << x.n
+       << ",\"p50_us\":" << us(x.p50)
+       << ",\"p95_us\":" << us(x.p95)
+       << ",\"p99_us\":" << us(x.p99)
+       << ",\"max_us\":" << us(x.max)
+       << ",\"allocs\":";
+    if (x.nAllocs < 0) {
+        os << "null";
+    } else {
+        os << x.nAllocs;
+    }
+    os << ",\"results\":" << x.nResults << "}\n";
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+///
+/// Latency statistics for search benchmarks
+///
+
+// STL
+#include <iosfwd>
+#include <span>
+#include <string_view>
+
+namespace srh {
+
+    ///  One run of one query
+    struct BenchSample {
+        long long ns = 0;       ///< wall time
+        long long nAllocs = 0;  ///< operator new calls, see nAllocs()
+        size_t nResults = 0;
+    };
+
+    struct BenchSummary {
+        size_t n = 0;
+        long long p50 = 0, p95 = 0, p99 = 0, max = 0;   ///< ns
+        long long nAllocs = -1;     ///< median, −1 = not counted
+        size_t nResults = 0;        ///< of the last run
+    };
+
+    /// Percentiles are nearest-rank
+    BenchSummary summarize(std::span<const BenchSample> samples);
+
+    /// @return  operator new calls so far, all threads;
+    ///          −1 if not counted (build w/o SEARCH_BENCH_ALLOCS)
+    long long nAllocs();
+
+    /// Writes one JSON line: {"kind":…,"name":…,"n":…,"p50_us":…}
+    void writeJsonLine(std::ostream& os, std::string_view kind,
+                       std::string_view name, const BenchSummary& x);
+
+}   // namespace srh
@@ -0,0 +1,184 @@
+// My header
+#include "benchRun.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// Unicode
+#include "UcData.h"
+
+// Search
+#include "bench.h"
+#include "request.h"
+#include "uc.h"
+
+namespace {
+
+    /// Realistic queries: what users type and paste
+    constexpr std::u8string_view SEARCH_CORPUS[] {
+        // Codes
+        u8"U+1F600", u8"1F600", u8"263A", u8"9731", u8"00A9",
+        // HTML mnemonics
+        u8"&amp;", u8"&Dagger;", u8"&nbsp;",
+        // Keywords
+        u8"a", u8"le", u8"latin", u8"latin small letter a",
+        u8"cyrillic", u8"grinning face", u8"arrow", u8"smiling cat",
+        u8"cjk", u8"box drawings light", u8"mathematical bold",
+        u8"cyrilic", u8"grining",       // typos
+        // Numerics
+        u8"1/2", u8"0.25", u8"12", u8"1000",
+        // Flags and emoji
+        u8"flag ua", u8"👍🏽", u8"🇺🇦", u8"👨‍👩‍👧‍👦",
+        // Patterns
+        u8"latin * letter * with hook", u8"/^CJK.*RADICAL/",
+        // Long pasted text
+        u8"Unicode® is a text encoding standard, «Юникод» — стандарт кодирования "
+          u8"символов 😀🇺🇦👍🏽, ∑∫√∞ ≠ ≈, αβγ, 漢字かなカナ, 한글, עברית, العربية, "
+          u8"देवनागरी, ქართული, ᚠᚢᚦᚨᚱᚲ — and it all goes into one debrief.",
+    };
+
+    struct RequestCase {
+        std::string_view name;
+        uc::CharFields fields;
+    };
+
+    const RequestCase REQUEST_CORPUS[] {
+        { "script=Cyrl",        { .ecScript = uc::EcScript::Cyrl } },
+        { "script=Hani",        { .ecScript = uc::EcScript::Hani } },
+        { "category=Nd",        { .ecCategory = uc::EcCategory::NUMBER_DECIMAL } },
+        { "version=15.0",       { .ecVersion = uc::EcVersion::V_15_0 } },
+        { "letter+script=Latn", { .ecScript = uc::EcScript::Latn,
+                                  .ecUpCat = uc::EcUpCategory::LETTER } },
+        { "number",             { .isNumber = true } },
+    };
+
+    /// Time to 1st screen: search itself, and lines that are shown at once
+    constexpr size_t N_FIRST_LINES = 50;
+
+    size_t touchResult(const uc::MultiResult& x)
+    {
+        size_t r = 0;
+        for (auto& group : x.groups) {
+            auto n = group.size();
+            for (size_t i = 0; i < std::min(n, N_FIRST_LINES); ++i)
+                group.lineAt(i);
+            r += n;
+        }
+        return r;
+    }
+
+    srh::BenchSample measure(const std::function<uc::MultiResult()>& body)
+    {
+        uc::clearSearchCache();
+        auto allocs0 = srh::nAllocs();
+        auto t0 = std::chrono::steady_clock::now();
+        auto result = body();
+        auto nResults = touchResult(result);
+        auto t1 = std::chrono::steady_clock::now();
+        auto allocs1 = srh::nAllocs();
+        return {
+            .ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(),
+            .nAllocs = (allocs0 < 0) ? -1 : allocs1 - allocs0,
+            .nResults = nResults };
+    }
+
+    void runCase(std::ostream& os, std::string_view kind, std::string_view name,
+                 unsigned nRuns, const std::function<uc::MultiResult()>& body)
+    {
+        SafeVector<srh::BenchSample> samples;
+        for (unsigned i = 0; i < nRuns; ++i)
+            samples.push_back(measure(body));
+        srh::writeJsonLine(os, kind, name, srh::summarize(samples));
+    }
+
+    ///// Name access ////////////////////////////////////////////////////////
+
+    struct NameCase {
+        std::string_view name;
+        uc::TextRole role;
+    };
+
+    constexpr NameCase NAME_CORPUS[] {
+        { "tech",   uc::TextRole::MAIN_NAME },
+        { "alt",    uc::TextRole::ALT_NAME },
+        { "abbrev", uc::TextRole::ABBREV },
+        { "html",   uc::TextRole::HTML },
+        { "emoji",  uc::TextRole::EMOJI_NAME },
+    };
+
+    /// Former way of getText: go through texts until that role
+    std::u8string_view traverseToRole(const uc::Cp& cp, uc::TextRole role)
+    {
+        return cp.name.traverseAllT([role](uc::TextRole aRole, std::u8string_view) {
+            return uc::stopIf(role == aRole);
+        });
+    }
+
+    /// Gets text of that role for every char
+    /// @return  # of chars having it
+    template <class Body>
+    size_t allNames(const Body& body)
+    {
+        size_t r = 0;
+        for (auto& cp : uc::cpInfo) {
+            if (!body(cp).empty())
+                ++r;
+        }
+        return r;
+    }
+
+    void runNameCase(std::ostream& os, std::string_view name,
+                     unsigned nRuns, const std::function<size_t()>& body)
+    {
+        SafeVector<srh::BenchSample> samples;
+        for (unsigned i = 0; i < nRuns; ++i) {
+            auto t0 = std::chrono::steady_clock::now();
+            auto nResults = body();
+            auto t1 = std::chrono::steady_clock::now();
+            samples.push_back({
+                .ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(),
+                .nAllocs = -1,
+                .nResults = nResults });
+        }
+        srh::writeJsonLine(os, "name", name, srh::summarize(samples));
+    }
+
+}   // anon namespace
+
+
+int uc::runSearchBench(const std::filesystem::path& fname, unsigned nRuns)
+{
+    std::ofstream os(fname);
+    if (!os.is_open())
+        return 1;
+
+    // 1st search builds indexes
+    auto toQ = [](std::u8string_view x) {
+        return QString::fromUtf8(reinterpret_cast<const char*>(x.data()), x.size());
+    };
+    runCase(os, "warmup", "index", 1, [&] { return uc::doSearch(toQ(u8"latin")); });
+
+    for (auto query : SEARCH_CORPUS) {
+        auto q = toQ(query);
+        std::string_view name { reinterpret_cast<const char*>(query.data()), query.size() };
+        runCase(os, "search", name, nRuns, [&q] { return uc::doSearch(q); });
+    }
+    for (auto& rq : REQUEST_CORPUS) {
+        uc::CharFieldRequest request(rq.fields);
+        runCase(os, "request", rq.name, nRuns, [&request] { return uc::doRequest(request); });
+    }
+    for (auto& nc : NAME_CORPUS) {
+        auto role = nc.role;
+        runNameCase(os, std::string{nc.name} + "/traverse", nRuns, [role] {
+            return allNames([role](const uc::Cp& cp) { return traverseToRole(cp, role); });
+        });
+        runNameCase(os, std::string{nc.name} + "/direct", nRuns, [role] {
+            return allNames([role](const uc::Cp& cp) { return cp.name.getText(role); });
+        });
+    }
+    return os.good() ? 0 : 1;
+}
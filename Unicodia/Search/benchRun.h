@@ -0,0 +1,20 @@
+#pragma once
+
+///
+/// Search benchmark over the real database: Unicodia --bench-search
+///
+
+// STL
+#include <filesystem>
+
+namespace uc {
+
+    /// Replays fixed query corpus against doSearch and doRequest,
+    ///   then times getting names of every role for all chars,
+    ///   traversing texts vs. direct (kind "name");
+    ///   writes JSON lines (see srh::writeJsonLine) to file
+    /// @param [in] nRuns   runs of every query, search cache is cleared before each
+    /// @return  exit code
+    int runSearchBench(const std::filesystem::path& fname, unsigned nRuns);
+
+}   // namespace uc
@@ -0,0 +1,90 @@
+// My header
+#include "bitmap.h"
+
+// STL
+#include <algorithm>
+
+
+srh::RunBitmap srh::RunBitmap::all(size_t n)
+{
+    RunBitmap r;
+    r.addRun(0, n);
+    return r;
+}
+
+
+void srh::RunBitmap::addRun(HayId beg, HayId end)
+{
+    if (beg >= end)
+        return;
+    if (!fRuns.empty() && fRuns.back().end >= beg) {
+        // Touches or overlaps the last one
+        fRuns.back().end = std::max(fRuns.back().end, end);
+    } else {
+        fRuns.push_back({ beg, end });
+    }
+}
+
+
+void srh::RunBitmap::add(HayId id)
+{
+    addRun(id, id + 1);
+}
+
+
+bool srh::RunBitmap::contains(HayId id) const
+{
+    auto it = std::upper_bound(fRuns.begin(), fRuns.end(), id,
+            [](HayId x, const Run& y) { return (x < y.beg); });
+    if (it == fRuns.begin())
+        return false;
+    --it;
+    return (id < it->end);
+}
+
+
+size_t srh::RunBitmap::count() const
+{
+    size_t r = 0;
+    for (auto& v : fRuns)
+        r += v.end - v.beg;
+    return r;
+}
+
+
+srh::RunBitmap srh::operator & (const RunBitmap& x, const RunBitmap& y)
+{
+    RunBitmap r;
+    auto p = x.fRuns.begin(), q = y.fRuns.begin();
+    while (p != x.fRuns.end() && q != y.fRuns.end()) {
+        auto beg = std::max(p->beg, q->beg);
+        auto end = std::min(p->end, q->end);
+        if (beg < end)
+            r.fRuns.push_back({ beg, end });   // never touch each other
+        // Throw away the one ending earlier
+        if (p->end < q->end) {
+            ++p;
+        } else {
+            ++q;
+        }
+    }
+    return r;
+}
+
+
+srh::RunBitmap srh::operator | (const RunBitmap& x, const RunBitmap& y)
+{
+    RunBitmap r;
+    auto p = x.fRuns.begin(), q = y.fRuns.begin();
+    while (p != x.fRuns.end() || q != y.fRuns.end()) {
+        // Take the one starting earlier
+        if (q == y.fRuns.end() || (p != x.fRuns.end() && p->beg < q->beg)) {
+            r.addRun(p->beg, p->end);
+            ++p;
+        } else {
+            r.addRun(q->beg, q->end);
+            ++q;
+        }
+    }
+    return r;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+///
+/// Run-length bitmap for property indexes
+///
+
+// STL
+#include <span>
+
+// Libs
+#include "u_Vector.h"
+
+// Search
+#include "index.h"
+
+namespace srh {
+
+    ///
+    ///  Set of IDs as sorted runs [beg, end) that neither overlap nor touch.
+    ///  Unicode properties go in long runs (blocks, scripts, versions…),
+    ///  so the bitmap is compact, and AND/OR go run by run.
+    ///
+    class RunBitmap
+    {
+    public:
+        struct Run {
+            HayId beg, end;
+            bool operator == (const Run&) const = default;
+        };
+
+        RunBitmap() = default;
+        /// @return [0, n)
+        static RunBitmap all(size_t n);
+
+        /// Adds ID, IDs should go in ascending order
+        void add(HayId id);
+        /// Adds [beg, end), runs should go in ascending order
+        void addRun(HayId beg, HayId end);
+
+        bool contains(HayId id) const;
+        bool isEmpty() const { return fRuns.empty(); }
+        size_t count() const;
+        std::span<const Run> runs() const { return fRuns; }
+
+        /// Traverses IDs in ascending order
+        template <class Body>
+        void forEach(const Body& body) const;
+
+        friend RunBitmap operator & (const RunBitmap& x, const RunBitmap& y);
+        friend RunBitmap operator | (const RunBitmap& x, const RunBitmap& y);
+        RunBitmap& operator &= (const RunBitmap& x) { return *this = (*this & x); }
+        RunBitmap& operator |= (const RunBitmap& x) { return *this = (*this | x); }
+        bool operator == (const RunBitmap& x) const = default;
+    private:
+        SafeVector<Run> fRuns;
+    };
+
+    RunBitmap operator & (const RunBitmap& x, const RunBitmap& y);
+    RunBitmap operator | (const RunBitmap& x, const RunBitmap& y);
+
+}   // namespace srh
+
+
+template <class Body>
+void srh::RunBitmap::forEach(const Body& body) const
+{
+    for (auto& run : fRuns) {
+        for (auto id = run.beg; id < run.end; ++id)
+            body(id);
+    }
+}
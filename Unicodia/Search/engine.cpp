@@ -112,6 +112,13 @@ bool srh::stringsCiEq(std::u8string_view s1, std::u8string_view s2)
 
 
 
+void srh::splitWords(
+        std::u8string_view haystack, SafeVector<std::u8string_view>& r)
+{
+    str::splitByAnySvTo(haystack, ALL_SEPARATORS, r);
+}
+
+
 ///// NeedleWord ///////////////////////////////////////////////////////////////
 
 
@@ -204,8 +211,21 @@ namespace {
 
 }   // anon namespace
 
+bool srh::isFuzzyFound(
+        std::span<const HayWord> haystack, const NeedleWord& needle)
+{
+    for (auto fw : needle.fuzzyWords) {
+        for (auto& hw : haystack) {
+            if (hw.sv() == fw)
+                return true;
+        }
+    }
+    return false;
+}
+
+
 srh::Place srh::findWord(
-        std::span<HayWord> haystack, const NeedleWord& needle,
+        std::span<const HayWord> haystack, const NeedleWord& needle,
         HaystackClass hclass, const Comparator& comparator)
 {
     bool isNeedleLowPrio = needle.lowPrioClass.have(hclass);
@@ -235,16 +255,19 @@ srh::Place srh::findWord(
         case Place::INITIAL:
         case Place::INITIAL_SRIPT:
         case Place::PARTIAL:
+        case Place::FUZZY:
             r = std::max(r, r1);
             [[fallthrough]];
         case Place::NONE: ;
         }
         pos = where.iWord + 1;
     }
+    if (r == Place::NONE && isFuzzyFound(haystack, needle))
+        r = Place::FUZZY;
     return r;
 }
 
-srh::Prio srh::findNeedle(std::span<HayWord> haystack, const Needle& needle,
+srh::Prio srh::findNeedle(std::span<const HayWord> haystack, const Needle& needle,
                           HaystackClass hclass, const Comparator& comparator)
 {
     srh::Prio r;
@@ -256,6 +279,7 @@ srh::Prio srh::findNeedle(std::span<HayWord> haystack, const Needle& needle,
         case Place::INITIAL: ++r.initial; break;
         case Place::INITIAL_SRIPT: ++r.initialScript; break;
         case Place::PARTIAL: ++r.partial; break;
+        case Place::FUZZY: ++r.fuzzy; break;
         case Place::NONE: ;
         }
     }
@@ -271,7 +295,7 @@ srh::Prio srh::findNeedle(std::u8string_view haystack, const Needle& needle,
     comparator.prepareHaystack(haystack, cache.haystack);
     // Words — simple
     cache.words1.clear();
-    str::splitByAnySvTo(cache.haystack, ALL_SEPARATORS, cache.words1);
+    splitWords(cache.haystack, cache.words1);
     // Words — bigger
     cache.words2.clear();
     cache.words2.reserve(cache.words1.size());
@@ -13,6 +13,8 @@ namespace srh {
     enum class Class { OTHER, LETTER, DIGIT };
 
     Class classify(char8_t x);
+    /// classify or its likes: what is word start
+    using Classifier = Class (*)(char8_t);
 
     enum class HaystackClass : unsigned char {
         NOWHERE = 0,        ///< Technical value
@@ -51,6 +53,9 @@ namespace srh {
         bool isDicWord = false;
         /// Interesting thing here: searching for “le” → avoid “letter”
         Flags<HaystackClass> lowPrioClass = HaystackClass::NOWHERE;
+        /// Dictionary words a few typos away, when the word itself is found nowhere
+        /// (see WordIndex::addFuzzyWords)
+        SafeVector<std::u8string_view> fuzzyWords;
 
         NeedleWord() = default;
         NeedleWord(std::u8string x);
@@ -70,7 +75,7 @@ namespace srh {
         size_t length() const { return v.length(); }
     };
 
-    enum class Place { NONE, PARTIAL, INITIAL_SRIPT, INITIAL, EXACT_SCRIPT, EXACT };
+    enum class Place { NONE, FUZZY, PARTIAL, INITIAL_SRIPT, INITIAL, EXACT_SCRIPT, EXACT };
 
     /// @brief
     ///   Just a normal T, but compares in reverse order
@@ -110,7 +115,7 @@ namespace srh {
         short high = 0;
         unsigned short exact = 0, exactScript = 0,
                        initial = 0, initialScript = 0,
-                       partial = 0;
+                       partial = 0, fuzzy = 0;
         std::partial_ordering operator <=>(const Prio& x) const = default;
         static const Prio EMPTY;
     };
@@ -133,14 +138,20 @@ namespace srh {
         SafeVector<HayWord> words2;
     };
 
-    Place findWord(std::span<HayWord> haystack, const NeedleWord& needle,
+    /// @return [+] some hay word is one of needle’s fuzzyWords
+    bool isFuzzyFound(std::span<const HayWord> haystack, const NeedleWord& needle);
+    Place findWord(std::span<const HayWord> haystack, const NeedleWord& needle,
                    HaystackClass hclass, const Comparator& comparator);
-    Prio findNeedle(std::span<HayWord> haystack, const Needle& needle,
+    Prio findNeedle(std::span<const HayWord> haystack, const Needle& needle,
                     HaystackClass hclass, const Comparator& comparator);
     Prio findNeedle(std::u8string_view haystack, const Needle& needle,
                     HaystackClass hclass, Cache& cache, const Comparator& comparator);
     bool stringsCiEq(std::u8string_view s1, std::u8string_view s2);
 
+    /// Splits prepared (see Comparator) haystack into words,
+    /// exactly as findNeedle does
+    void splitWords(std::u8string_view haystack, SafeVector<std::u8string_view>& r);
+
     class DefaultComparator : public Comparator
     {
     public:
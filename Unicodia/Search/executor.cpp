@@ -0,0 +1,71 @@
+// My header
+#include "executor.h"
+
+
+uc::SearchExecutor::SearchExecutor(QObject* parent)
+    : QObject(parent),
+      thread([this](std::stop_token stopToken) { run(stopToken); }) {}
+
+
+uc::SearchExecutor::~SearchExecutor()
+{
+    {   std::lock_guard lk(mut);
+        currentStop.request_stop();
+    }
+    thread.request_stop();
+    thread.join();
+}
+
+
+void uc::SearchExecutor::start(const QString& what, SearchMode mode)
+{
+    std::lock_guard lk(mut);
+    currentStop.request_stop();
+    pending = Task { .what = what, .mode = mode, .serial = ++serial };
+    cond.notify_one();
+}
+
+
+void uc::SearchExecutor::cancel()
+{
+    std::lock_guard lk(mut);
+    currentStop.request_stop();
+    pending.reset();
+    ++serial;
+}
+
+
+void uc::SearchExecutor::run(std::stop_token stopToken)
+{
+    while (true) {
+        Task task;
+        std::stop_token taskStop;
+        {   std::unique_lock lk(mut);
+            if (!cond.wait(lk, stopToken, [this] { return pending.has_value(); }))
+                return;
+            task = std::move(*pending);
+            pending.reset();
+            currentStop = std::stop_source{};
+            taskStop = currentStop.get_token();
+        }
+        auto result = std::make_shared<uc::MultiResult>(
+                uc::doSearch(task.what, &session, taskStop));
+        if (taskStop.stop_requested())
+            continue;
+        // Functor’s context is this → nothing is called after destruction
+        QMetaObject::invokeMethod(this,
+            [this, result, mode = task.mode, aSerial = task.serial] {
+                deliver(result, mode, aSerial);
+            }, Qt::QueuedConnection);
+    }
+}
+
+
+void uc::SearchExecutor::deliver(
+        std::shared_ptr<uc::MultiResult> result, SearchMode mode, unsigned aSerial)
+{
+    // Newer search started meanwhile
+    if (aSerial != serial)
+        return;
+    emit finished(std::move(result), mode);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+///
+/// Search in a separate thread
+///
+
+// STL
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
+// Qt
+#include <QObject>
+
+// Search
+#include "Search/session.h"
+#include "Search/uc.h"
+
+namespace uc {
+
+    enum class SearchMode : unsigned char {
+        EXPLICIT,   ///< user pressed Enter
+        LIVE        ///< search-as-you-type
+    };
+
+    ///
+    ///  Runs searches one by one in a worker thread.
+    ///  Newer search cancels older one, and only the newest result
+    ///  is delivered to GUI thread.
+    ///
+    class SearchExecutor : public QObject
+    {
+        Q_OBJECT
+    public:
+        SearchExecutor(QObject* parent = nullptr);
+        ~SearchExecutor() override;
+
+        /// Starts search, cancelling previous one
+        void start(const QString& what, SearchMode mode);
+        /// Cancels current search, nothing will be delivered
+        void cancel();
+    signals:
+        /// Emitted in owner’s (GUI) thread
+        void finished(std::shared_ptr<uc::MultiResult> result, uc::SearchMode mode);
+    private:
+        struct Task {
+            QString what;
+            SearchMode mode;
+            unsigned serial;
+        };
+
+        std::mutex mut;
+        std::condition_variable_any cond;
+        std::optional<Task> pending;
+        std::stop_source currentStop;
+        unsigned serial = 0;            ///< accessed from owner’s thread only
+        srh::Session session;           ///< accessed from worker only
+        std::jthread thread;            ///< last, as it uses all above
+
+        void run(std::stop_token stopToken);
+        void deliver(std::shared_ptr<uc::MultiResult> result,
+                     SearchMode mode, unsigned aSerial);
+    };
+
+}   // namespace uc
@@ -0,0 +1,105 @@
+// My header
+#include "fold.h"
+
+const srh::FoldComparator srh::FoldComparator::INST;
+
+
+namespace {
+
+    /// U+00C0…00FF → ASCII, 0 = keep
+    constexpr char LATIN1[65] =
+        "AAAAAA\0CEEEEIIII"     // C0
+        "DNOOOOO\0OUUUUY\0\0"   // D0
+        "AAAAAA\0CEEEEIIII"     // E0
+        "DNOOOOO\0OUUUUY\0Y";   // F0
+
+    /// Cyrillic U+0400…04FF → upper case
+    constexpr char32_t foldCyrillic(char32_t x)
+    {
+        if (x >= 0x430 && x <= 0x44F)       // а…я
+            x -= 0x20;
+        else if (x >= 0x450 && x <= 0x45F)  // ѐ…џ
+            x -= 0x50;
+        else if ((x >= 0x460 && x <= 0x481) || (x >= 0x48A && x <= 0x4BF)
+                 || (x >= 0x4D0 && x <= 0x4FF))     // even upper, odd lower
+            x &= ~char32_t(1);
+        else if (x >= 0x4C1 && x <= 0x4CE)  // odd upper, even lower
+            x -= (~x & 1);
+        switch (x) {
+        case 0x400:     // Ѐ
+        case 0x401:     // Ё
+            return 0x415;   // Е
+        default:
+            return x;
+        }
+    }
+
+    inline void appendUtf8x2(char32_t x, std::u8string& r)
+    {
+        r.push_back(char8_t(0xC0 | (x >> 6)));
+        r.push_back(char8_t(0x80 | (x & 0x3F)));
+    }
+
+}   // anon namespace
+
+
+void srh::fold(std::u8string_view x, std::u8string& r)
+{
+    r.clear();
+    r.reserve(x.length());
+    for (size_t i = 0; i < x.length(); ++i) {
+        char8_t c = x[i];
+        if (c < 0x80) {
+            r.push_back((c >= 'a' && c <= 'z') ? char8_t(c - ('a' - 'A')) : c);
+            continue;
+        }
+        // 2-byte sequences only: Latin-1, Cyrillic
+        if ((c & 0xE0) == 0xC0 && i + 1 < x.length()
+                && (x[i + 1] & 0xC0) == 0x80) {
+            char32_t cp = ((c & 0x1F) << 6) | (x[i + 1] & 0x3F);
+            if (cp >= 0xC0 && cp <= 0xFF) {
+                if (auto q = LATIN1[cp - 0xC0]) {
+                    r.push_back(char8_t(q));
+                    ++i;
+                    continue;
+                }
+            } else if (cp >= 0x400 && cp <= 0x4FF) {
+                appendUtf8x2(foldCyrillic(cp), r);
+                ++i;
+                continue;
+            }
+        }
+        r.push_back(c);
+    }
+}
+
+
+std::u8string srh::fold(std::u8string_view x)
+{
+    std::u8string r;
+    fold(x, r);
+    return r;
+}
+
+
+srh::Class srh::classifyFolded(char8_t x)
+{
+    if (x >= 0x80)
+        return Class::LETTER;
+    return classify(x);
+}
+
+
+srh::FindStatus srh::FoldComparator::find(
+        std::u8string_view haystack, std::u8string_view needle) const
+{
+    auto pos = haystack.find(needle);
+    if (pos == std::u8string_view::npos)
+        return FindStatus::NONE;
+    if (pos == 0) {
+        return (haystack.length() == needle.length())
+                ? FindStatus::COMPLETE : FindStatus::INITIAL;
+    }
+    return (classifyFolded(haystack[pos - 1]) == Class::OTHER)
+            ? FindStatus::INITIAL : FindStatus::SUBSTR;
+}
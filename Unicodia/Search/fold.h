@@ -0,0 +1,37 @@
+#pragma once
+
+///
+/// Case and accent folding for localized names
+///
+
+#include "engine.h"
+
+namespace srh {
+
+    /// Folds UTF-8 string for search: ASCII and Cyrillic → upper case,
+    ///   Latin-1 accented letters → ASCII, Ё → Е; everything else as is.
+    /// Table-driven, no hash lookups: localized names are many.
+    void fold(std::u8string_view x, std::u8string& r);
+    std::u8string fold(std::u8string_view x);
+
+    /// Same as classify, but UTF-8 bytes are letters:
+    ///   localized names have no separators beyond ASCII
+    Class classifyFolded(char8_t x);
+
+    ///
+    ///  Unlike NonAsciiComparator, keeps non-ASCII chars:
+    ///  for localized names and needles
+    ///
+    class FoldComparator final : public Comparator
+    {
+    public:
+        void prepareHaystack(
+                std::u8string_view haystack, std::u8string& result) const override
+            { fold(haystack, result); }
+        /// Same as DefaultComparator, but word start is by classifyFolded
+        srh::FindStatus find(
+                std::u8string_view haystack, std::u8string_view needle) const override;
+        static const FoldComparator INST;
+    };
+
+}   // namespace srh
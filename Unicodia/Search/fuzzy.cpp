@@ -0,0 +1,53 @@
+// My header
+#include "fuzzy.h"
+
+// STL
+#include <algorithm>
+
+
+srh::LevenshteinAutomaton::LevenshteinAutomaton(
+        std::u8string_view word, unsigned maxDistance)
+    : fWord(word.substr(0, MAX_LENGTH)), fMaxDistance(maxDistance) {}
+
+
+auto srh::LevenshteinAutomaton::start() const -> State
+{
+    State r;
+    for (size_t i = 0; i <= fWord.length(); ++i)
+        r[i] = i;
+    return r;
+}
+
+
+auto srh::LevenshteinAutomaton::step(const State& state, char8_t c) const -> State
+{
+    State r;
+    // Saturate: values over maxDistance mean nothing, but should not overflow
+    const unsigned limit = fMaxDistance + 1;
+    r[0] = std::min<unsigned>(state[0] + 1, limit);
+    for (size_t i = 0; i < fWord.length(); ++i) {
+        unsigned replace = state[i] + (fWord[i] != c);
+        unsigned insert = state[i + 1] + 1;
+        unsigned remove = r[i] + 1;
+        r[i + 1] = std::min({ replace, insert, remove, limit });
+    }
+    return r;
+}
+
+
+bool srh::LevenshteinAutomaton::canMatch(const State& state) const
+{
+    auto end = state.begin() + fWord.length() + 1;
+    return (*std::min_element(state.begin(), end) <= fMaxDistance);
+}
+
+
+unsigned srh::maxTypos(size_t wordLength)
+{
+    // Short words: too many similar words, CAT/CAR/CUT…
+    if (wordLength < 4)
+        return 0;
+    if (wordLength < 8)
+        return 1;
+    return 2;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+///
+/// Levenshtein automaton for typo-tolerant search
+///
+
+// STL
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace srh {
+
+    ///
+    ///  Accepts words within maxDistance edits (insert, delete, replace)
+    ///  of a given word. State is a row of Levenshtein matrix,
+    ///  so it is stepped char by char along a sorted word list or trie,
+    ///  and dead states cut whole prefixes.
+    ///
+    class LevenshteinAutomaton
+    {
+    public:
+        static constexpr size_t MAX_LENGTH = 47;
+        using State = std::array<uint8_t, MAX_LENGTH + 1>;
+
+        /// @pre  word.length() <= MAX_LENGTH
+        LevenshteinAutomaton(std::u8string_view word, unsigned maxDistance);
+
+        State start() const;
+        State step(const State& state, char8_t c) const;
+        /// @return [+] word read so far is within distance
+        bool isMatch(const State& state) const
+            { return state[fWord.length()] <= fMaxDistance; }
+        /// @return [+] some continuation may be within distance
+        bool canMatch(const State& state) const;
+        /// @return distance of word read so far, meaningful if isMatch
+        unsigned distance(const State& state) const
+            { return state[fWord.length()]; }
+    private:
+        std::u8string_view fWord;
+        unsigned fMaxDistance;
+    };
+
+    /// @return  how many typos we tolerate in needle word: 0 = no fuzzy search
+    unsigned maxTypos(size_t wordLength);
+
+}   // namespace srh
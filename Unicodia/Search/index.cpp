@@ -0,0 +1,196 @@
+// My header
+#include "index.h"
+
+// STL
+#include <algorithm>
+
+// Search
+#include "fuzzy.h"
+
+
+///// IdSet ////////////////////////////////////////////////////////////////////
+
+
+void srh::IdSet::reset(size_t n)
+{
+    fCapacity = n;
+    v.assign((n + 63) >> 6, 0);
+}
+
+
+bool srh::IdSet::isEmpty() const
+{
+    return std::all_of(v.begin(), v.end(),
+                       [](uint64_t x) { return (x == 0); });
+}
+
+
+///// WordIndex ////////////////////////////////////////////////////////////////
+
+
+void srh::WordIndex::add(HayId id, std::u8string_view preparedHaystack)
+{
+    tempWords.clear();
+    splitWords(preparedHaystack, tempWords);
+    for (auto v : tempWords) {
+        if (v.empty())
+            continue;
+        auto& list = building[std::u8string{v}];
+        // Haystacks go in ascending order, so checking the last is enough
+        if (list.empty() || list.back() != id)
+            list.push_back(id);
+    }
+}
+
+
+void srh::WordIndex::finish(size_t nIds)
+{
+    struct Src {
+        std::u8string_view word;
+        const SafeVector<HayId>* list;
+    };
+    SafeVector<Src> src;
+    src.reserve(building.size());
+    size_t textLength = 0, nPostings = 0;
+    for (auto& [k, v] : building) {
+        src.push_back({ k, &v });
+        textLength += k.length() + 1;
+        nPostings += v.size();
+    }
+    std::sort(src.begin(), src.end(),
+              [](const Src& x, const Src& y) { return (x.word < y.word); });
+
+    fText.clear();
+    fText.reserve(textLength);
+    words.clear();
+    words.reserve(src.size() + 1);
+    postings.clear();
+    postings.reserve(nPostings);
+    for (auto& v : src) {
+        words.push_back({
+                .offset = static_cast<uint32_t>(fText.length()),
+                .length = static_cast<uint32_t>(v.word.length()),
+                .iPosting = static_cast<uint32_t>(postings.size()) });
+        fText.append(v.word);
+        fText.push_back(0);
+        postings.insert(postings.end(), v.list->begin(), v.list->end());
+    }
+    // Terminating word
+    words.push_back({
+            .offset = static_cast<uint32_t>(fText.length()),
+            .length = 0,
+            .iPosting = static_cast<uint32_t>(postings.size()) });
+
+    // Free building data
+    building = {};
+    tempWords = {};
+    fNIds = nIds;
+    fIsFinished = true;
+}
+
+
+void srh::WordIndex::markWord(size_t iWord, IdSet& r) const
+{
+    auto a = words[iWord].iPosting;
+    auto b = words[iWord + 1].iPosting;
+    for (auto i = a; i < b; ++i)
+        r.add(postings[i]);
+}
+
+
+size_t srh::WordIndex::wordByPos(size_t pos) const
+{
+    const auto wBeg = words.begin();
+    const auto wEnd = words.end() - 1;
+    auto it = std::upper_bound(wBeg, wEnd, pos,
+            [](size_t x, const Word& y) { return (x < y.offset); });
+    return (it - wBeg) - 1;   // never at begin: the 1st word has offset 0
+}
+
+
+void srh::WordIndex::findCandidates(const Needle& needle, IdSet& r) const
+{
+    // Just one search over all text: words are separated with zeroes,
+    // and needles contain neither zeroes nor separators
+    const std::u8string_view text = fText;
+    for (auto& nw : needle.words) {
+        if (nw.v.empty())
+            continue;
+        size_t pos = 0;
+        while (true) {
+            pos = text.find(nw.sv(), pos);
+            if (pos == std::u8string_view::npos)
+                break;
+            auto iWord = wordByPos(pos);
+            markWord(iWord, r);
+            // Go to next word
+            pos = words[iWord].offset + words[iWord].length + 1;
+        }
+        for (auto fw : nw.fuzzyWords)
+            markWord(wordByPos(fw.data() - text.data()), r);
+    }
+}
+
+
+void srh::WordIndex::addFuzzyWords(Needle& needle) const
+{
+    static constexpr size_t MAX_FUZZY_WORDS = 32;
+    const std::u8string_view text = fText;
+    const size_t nWords = words.size() - 1;
+    for (auto& nw : needle.words) {
+        nw.fuzzyWords.clear();
+        auto maxDist = maxTypos(nw.length());
+        if (maxDist == 0 || nw.length() > LevenshteinAutomaton::MAX_LENGTH
+                || text.find(nw.sv()) != std::u8string_view::npos)
+            continue;
+
+        // Words are sorted → go like over trie, reusing states of common prefix
+        LevenshteinAutomaton automaton(nw.sv(), maxDist);
+        SafeVector<LevenshteinAutomaton::State> states { automaton.start() };
+        struct Found {
+            unsigned distance;
+            std::u8string_view word;
+        };
+        SafeVector<Found> found;
+        std::u8string_view prev;
+        size_t iWord = 0;
+        while (iWord < nWords) {
+            auto word = wordAt(iWord);
+            auto common = std::mismatch(word.begin(), word.end(), prev.begin(), prev.end());
+            size_t depth = std::min<size_t>(common.first - word.begin(), states.size() - 1);
+            states.resize(depth + 1);
+            bool isDead = false;
+            for (; depth < word.length(); ++depth) {
+                states.push_back(automaton.step(states.back(), word[depth]));
+                if (!automaton.canMatch(states.back())) {
+                    isDead = true;
+                    break;
+                }
+            }
+            if (isDead) {
+                // Skip all words with this prefix
+                auto prefix = word.substr(0, depth + 1);
+                auto it = std::partition_point(
+                        words.begin() + iWord + 1, words.begin() + nWords,
+                        [this, prefix](const Word& x) {
+                            return wordAt(&x - words.data()).starts_with(prefix);
+                        });
+                states.pop_back();
+                prev = prefix.substr(0, depth);
+                iWord = it - words.begin();
+                continue;
+            }
+            if (automaton.isMatch(states.back()))
+                found.push_back({ automaton.distance(states.back()), word });
+            prev = word;
+            ++iWord;
+        }
+        // Closest first
+        std::stable_sort(found.begin(), found.end(),
+                [](const Found& x, const Found& y) { return (x.distance < y.distance); });
+        if (found.size() > MAX_FUZZY_WORDS)
+            found.resize(MAX_FUZZY_WORDS);
+        for (auto& v : found)
+            nw.fuzzyWords.push_back(v.word);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+///
+/// Inverted word index for keyword search
+///
+
+// STL
+#include <cstdint>
+#include <bit>
+#include <unordered_map>
+
+// Libs
+#include "u_Vector.h"
+
+// Search
+#include "engine.h"
+
+namespace srh {
+
+    using HayId = uint32_t;
+
+    ///
+    ///  Set of haystack IDs, simple bitset
+    ///
+    class IdSet
+    {
+    public:
+        /// Makes set of n empty places
+        void reset(size_t n);
+        size_t capacity() const { return fCapacity; }
+
+        void add(HayId x)
+            { v[x >> 6] |= (uint64_t(1) << (x & 63)); }
+        bool contains(HayId x) const
+            { return (x < fCapacity) && (v[x >> 6] & (uint64_t(1) << (x & 63))); }
+        bool isEmpty() const;
+
+        /// Traverses IDs in ascending order
+        template <class Body>
+        void forEach(const Body& body) const;
+    private:
+        SafeVector<uint64_t> v;
+        size_t fCapacity = 0;
+    };
+
+    ///
+    ///  Inverted index: hay word → haystacks where it is present
+    ///
+    ///  Usage: add all haystacks, then finish.
+    ///  Haystacks are prepared by Comparator, and the index relies on
+    ///  Comparator::find being a substring search, as DefaultComparator’s.
+    ///
+    class WordIndex
+    {
+    public:
+        /// Adds all words of prepared haystack
+        void add(HayId id, std::u8string_view preparedHaystack);
+        /// Builds index from what was added
+        void finish(size_t nIds);
+
+        /// @return [+] index was finished
+        bool isFinished() const { return fIsFinished; }
+        size_t nIds() const { return fNIds; }
+        size_t nWords() const { return words.size(); }
+
+        /// Adds to r every haystack where at least one needle word
+        ///   is found as a substring of some hay word,
+        ///   or one of its fuzzy words is a hay word
+        /// @pre  r is reset to nIds()
+        void findCandidates(const Needle& needle, IdSet& r) const;
+        /// For every needle word found nowhere, finds fuzzyWords:
+        ///   index words a few typos away (see maxTypos)
+        /// @warning  fuzzyWords point inside the index
+        void addFuzzyWords(Needle& needle) const;
+    private:
+        struct Word {
+            uint32_t offset;        ///< in fText
+            uint32_t length;
+            uint32_t iPosting;      ///< 1st posting; last is next word’s iPosting
+        };
+        /// All distinct words, alphabetical, separated by zero
+        std::u8string fText;
+        SafeVector<Word> words;     ///< +1 terminating word
+        SafeVector<HayId> postings;
+        size_t fNIds = 0;
+        bool fIsFinished = false;
+
+        // Building data
+        std::unordered_map<std::u8string, SafeVector<HayId>> building;
+        SafeVector<std::u8string_view> tempWords;
+
+        void markWord(size_t iWord, IdSet& r) const;
+        std::u8string_view wordAt(size_t iWord) const
+            { return std::u8string_view{ fText }.substr(words[iWord].offset, words[iWord].length); }
+        /// @return  index of word that starts at text position pos
+        size_t wordByPos(size_t pos) const;
+    };
+
+}   // namespace srh
+
+
+template <class Body>
+void srh::IdSet::forEach(const Body& body) const
+{
+    for (size_t i = 0; i < v.size(); ++i) {
+        auto q = v[i];
+        while (q != 0) {
+            auto iBit = std::countr_zero(q);
+            body(static_cast<HayId>((i << 6) + iBit));
+            q &= (q - 1);
+        }
+    }
+}
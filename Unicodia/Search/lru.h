@@ -0,0 +1,101 @@
+#pragma once
+
+///
+/// Bounded cache with least-recently-used eviction
+///
+
+// STL
+#include <list>
+#include <unordered_map>
+
+namespace srh {
+
+    ///
+    ///  Bounded by number of items and total weight (say, number of
+    ///  results inside), the least recently used go away first.
+    ///  Counts hits and misses.
+    ///
+    ///  Not thread-safe.
+    ///
+    template <class K, class V>
+    class LruCache
+    {
+    public:
+        LruCache(size_t aMaxSize, size_t aMaxWeight)
+            : fMaxSize(aMaxSize), fMaxWeight(aMaxWeight) {}
+
+        /// @return [+] found, it becomes the most recent  [0] not found
+        const V* find(const K& key);
+        /// Adds/replaces value, evicting old ones
+        /// @warning  value heavier than maxWeight is not added
+        void put(const K& key, V value, size_t weight = 1);
+        void clear();
+
+        size_t size() const { return items.size(); }
+        size_t weight() const { return fWeight; }
+        size_t nHits() const { return fNHits; }
+        size_t nMisses() const { return fNMisses; }
+    private:
+        struct Item {
+            K key;
+            V value;
+            size_t weight;
+        };
+        using List = std::list<Item>;
+        List items;     ///< most recent first
+        std::unordered_map<K, typename List::iterator> index;
+        size_t fMaxSize, fMaxWeight, fWeight = 0;
+        size_t fNHits = 0, fNMisses = 0;
+
+        void erase(typename List::iterator it);
+    };
+
+}   // namespace srh
+
+
+template <class K, class V>
+const V* srh::LruCache<K, V>::find(const K& key)
+{
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++fNMisses;
+        return nullptr;
+    }
+    ++fNHits;
+    items.splice(items.begin(), items, it->second);
+    return &it->second->value;
+}
+
+
+template <class K, class V>
+void srh::LruCache<K, V>::erase(typename List::iterator it)
+{
+    fWeight -= it->weight;
+    index.erase(it->key);
+    items.erase(it);
+}
+
+
+template <class K, class V>
+void srh::LruCache<K, V>::put(const K& key, V value, size_t weight)
+{
+    if (auto it = index.find(key); it != index.end())
+        erase(it->second);
+    if (weight > fMaxWeight || fMaxSize == 0)
+        return;
+    while (!items.empty()
+            && (items.size() >= fMaxSize || fWeight + weight > fMaxWeight))
+        erase(std::prev(items.end()));
+    items.push_front(Item{ key, std::move(value), weight });
+    index.emplace(key, items.begin());
+    fWeight += weight;
+}
+
+
+template <class K, class V>
+void srh::LruCache<K, V>::clear()
+{
+    items.clear();
+    index.clear();
+    fWeight = 0;
+}
@@ -0,0 +1,353 @@
+// My header
+#include "matcher.h"
+
+// STL
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SRH_X86 1
+    #include <immintrin.h>
+#endif
+
+
+namespace {
+
+    constexpr size_t NO_POS = std::numeric_limits<size_t>::max();
+
+    ///
+    ///  State of one needle word while passing haystack
+    ///
+    struct WordState {
+        std::u8string_view needle;
+        size_t lastStart = NO_POS;          ///< last position where needle may start
+        size_t nextPos = 0;                 ///< do not search before it
+        size_t iWord = 0;                   ///< hay word we are in
+        srh::Place place = srh::Place::NONE;
+        bool isDone = false;
+    };
+
+    ///
+    ///  What’s common for all kernels: haystack and how to react on match
+    ///
+    class Pass
+    {
+    public:
+        Pass(std::u8string_view aPrepared, std::span<const srh::HayWord> aWords,
+             const srh::Needle& aNeedle, srh::HaystackClass aHclass,
+             srh::Classifier aCls, std::span<srh::Place> r);
+        std::u8string_view prepared;
+        std::span<const srh::HayWord> words;
+        const srh::Needle& needle;
+        srh::HaystackClass hclass;
+        srh::Classifier cls;
+        std::span<WordState> states;
+
+        /// Needle k starts at pos (first and last chars already checked)
+        void tryMatch(size_t k, size_t pos);
+        /// Needle k found at pos
+        void onMatch(size_t k, size_t pos);
+        /// Writes results
+        void finish(std::span<srh::Place> r);
+        /// @return [+] all needle words are done
+        bool isDone() const;
+    private:
+        /// Most searches are 1…3 words, so let’s avoid allocation
+        static constexpr size_t N_LOCAL = 8;
+        WordState localStates[N_LOCAL];
+        SafeVector<WordState> bigStates;
+    };
+
+    Pass::Pass(std::u8string_view aPrepared, std::span<const srh::HayWord> aWords,
+               const srh::Needle& aNeedle, srh::HaystackClass aHclass,
+               srh::Classifier aCls, std::span<srh::Place> r)
+        : prepared(aPrepared), words(aWords), needle(aNeedle), hclass(aHclass),
+          cls(aCls)
+    {
+        auto n = needle.words.size();
+        if (n <= N_LOCAL) {
+            states = std::span{ localStates, n };
+        } else {
+            bigStates.resize(n);
+            states = bigStates;
+        }
+        for (size_t k = 0; k < n; ++k) {
+            auto& st = states[k];
+            st.needle = needle.words[k].sv();
+            r[k] = srh::Place::NONE;
+            if (st.needle.empty() || st.needle.length() > prepared.length()) {
+                st.isDone = true;
+            } else {
+                st.lastStart = prepared.length() - st.needle.length();
+            }
+        }
+    }
+
+    inline void Pass::tryMatch(size_t k, size_t pos)
+    {
+        auto& st = states[k];
+        if (pos < st.nextPos || pos > st.lastStart)
+            return;
+        auto len = st.needle.length();
+        if (len > 2 && std::memcmp(prepared.data() + pos + 1,
+                                   st.needle.data() + 1, len - 2) != 0)
+            return;
+        onMatch(k, pos);
+    }
+
+    void Pass::onMatch(size_t k, size_t pos)
+    {
+        auto& st = states[k];
+        const auto* const p = prepared.data() + pos;
+        // Find hay word: needle never contains separators → inside one word
+        while (st.iWord < words.size()
+               && words[st.iWord].v.data() + words[st.iWord].length() <= p)
+            ++st.iWord;
+        if (st.iWord >= words.size()) {     // Should not happen
+            st.isDone = true;
+            return;
+        }
+        auto& word = words[st.iWord];
+        // Same as DefaultComparator::find: the 1st occurrence in word only
+        srh::Place place = srh::Place::PARTIAL;
+        if (p == word.v.data()) {
+            if (word.length() == st.needle.length()) {
+                place = needle.words[k].lowPrioClass.have(hclass)
+                        ? srh::Place::EXACT_SCRIPT : srh::Place::EXACT;
+                st.isDone = true;   // Same as early exit of findWord
+            } else {
+                place = word.lowPrioClass.have(hclass)
+                        ? srh::Place::INITIAL_SRIPT : srh::Place::INITIAL;
+            }
+        } else if (cls(p[-1]) == srh::Class::OTHER) {
+            place = word.lowPrioClass.have(hclass)
+                    ? srh::Place::INITIAL_SRIPT : srh::Place::INITIAL;
+        }
+        st.place = std::max(st.place, place);
+        // Go to next word
+        st.nextPos = (word.v.data() - prepared.data()) + word.length() + 1;
+        ++st.iWord;
+        if (st.nextPos > st.lastStart)
+            st.isDone = true;
+    }
+
+    bool Pass::isDone() const
+    {
+        return std::all_of(states.begin(), states.end(),
+                           [](const WordState& x) { return x.isDone; });
+    }
+
+    void Pass::finish(std::span<srh::Place> r)
+    {
+        for (size_t k = 0; k < states.size(); ++k) {
+            auto place = states[k].place;
+            if (place == srh::Place::NONE
+                    && srh::isFuzzyFound(words, needle.words[k]))
+                place = srh::Place::FUZZY;
+            r[k] = place;
+        }
+    }
+
+    ///// Scalar ///////////////////////////////////////////////////////////////
+
+    /// @param [in] kBegin  1st needle word to search, previous are done
+    void runScalar(Pass& pass, size_t kBegin = 0)
+    {
+        for (size_t k = kBegin; k < pass.states.size(); ++k) {
+            auto& st = pass.states[k];
+            while (!st.isDone) {
+                auto pos = pass.prepared.find(st.needle, st.nextPos);
+                if (pos == std::u8string_view::npos)
+                    break;
+                pass.onMatch(k, pos);
+            }
+        }
+    }
+
+    ///// SIMD /////////////////////////////////////////////////////////////////
+
+    ///  Muła’s approach: compare first and last chars of needle
+    ///  for W positions at once, then check the rest
+
+#ifdef SRH_X86
+
+    template <class Bits>
+    inline void processBits(Pass& pass, size_t k, size_t base, Bits mask)
+    {
+        while (mask != 0) {
+            auto iBit = std::countr_zero(mask);
+            pass.tryMatch(k, base + iBit);
+            if (pass.states[k].isDone)
+                return;
+            mask &= (mask - 1);
+        }
+    }
+
+    __attribute__((target("sse2")))
+    void runSse2(Pass& pass)
+    {
+        constexpr size_t W = 16;
+        const auto* const hay = pass.prepared.data();
+        __m128i firsts[64], lasts[64];      // the rest go via scalar
+        const auto nVector = std::min<size_t>(pass.states.size(), std::size(firsts));
+        for (size_t k = 0; k < nVector; ++k) {
+            auto& st = pass.states[k];
+            if (st.isDone) continue;
+            firsts[k] = _mm_set1_epi8(static_cast<char>(st.needle.front()));
+            lasts[k] = _mm_set1_epi8(static_cast<char>(st.needle.back()));
+        }
+        for (size_t i = 0; i < pass.prepared.length(); i += W) {
+            bool hasMore = false;
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+            for (size_t k = 0; k < nVector; ++k) {
+                auto& st = pass.states[k];
+                if (st.isDone || i > st.lastStart)
+                    continue;
+                hasMore = true;
+                auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                            hay + i + st.needle.length() - 1));
+                auto eq = _mm_and_si128(_mm_cmpeq_epi8(block, firsts[k]),
+                                        _mm_cmpeq_epi8(blockLast, lasts[k]));
+                auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+                processBits(pass, k, i, mask);
+            }
+            if (!hasMore)
+                break;
+        }
+        runScalar(pass, nVector);
+    }
+
+    __attribute__((target("avx2")))
+    void runAvx2(Pass& pass)
+    {
+        constexpr size_t W = 32;
+        const auto* const hay = pass.prepared.data();
+        __m256i firsts[64], lasts[64];      // the rest go via scalar
+        const auto nVector = std::min<size_t>(pass.states.size(), std::size(firsts));
+        for (size_t k = 0; k < nVector; ++k) {
+            auto& st = pass.states[k];
+            if (st.isDone) continue;
+            firsts[k] = _mm256_set1_epi8(static_cast<char>(st.needle.front()));
+            lasts[k] = _mm256_set1_epi8(static_cast<char>(st.needle.back()));
+        }
+        for (size_t i = 0; i < pass.prepared.length(); i += W) {
+            bool hasMore = false;
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+            for (size_t k = 0; k < nVector; ++k) {
+                auto& st = pass.states[k];
+                if (st.isDone || i > st.lastStart)
+                    continue;
+                hasMore = true;
+                auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                            hay + i + st.needle.length() - 1));
+                auto eq = _mm256_and_si256(_mm256_cmpeq_epi8(block, firsts[k]),
+                                           _mm256_cmpeq_epi8(blockLast, lasts[k]));
+                auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+                processBits(pass, k, i, mask);
+            }
+            if (!hasMore)
+                break;
+        }
+        runScalar(pass, nVector);
+    }
+
+#endif  // SRH_X86
+
+}   // anon namespace
+
+
+bool srh::isSupported(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::SCALAR:
+        return true;
+#ifdef SRH_X86
+    case Kernel::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case Kernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+#else
+    case Kernel::SSE2:
+    case Kernel::AVX2:
+        return false;
+#endif
+    }
+    return false;
+}
+
+
+srh::Kernel srh::bestKernel()
+{
+    // Unicode names are short, mostly one 32-byte block,
+    // and AVX2 does not pay off on them (see benchmark in UnitTest)
+    static const Kernel r = [] {
+        if (isSupported(Kernel::SSE2))
+            return Kernel::SSE2;
+        return Kernel::SCALAR;
+    }();
+    return r;
+}
+
+
+void srh::findPlaces(Kernel kernel,
+        std::u8string_view prepared, std::span<const HayWord> words,
+        const Needle& needle, HaystackClass hclass, std::span<Place> r,
+        Classifier cls)
+{
+    Pass pass(prepared, words, needle, hclass, cls, r);
+    if (pass.isDone()) {
+        pass.finish(r);
+        return;
+    }
+    switch (kernel) {
+#ifdef SRH_X86
+    case Kernel::SSE2:
+        runSse2(pass);
+        break;
+    case Kernel::AVX2:
+        runAvx2(pass);
+        break;
+#else
+    case Kernel::SSE2:
+    case Kernel::AVX2:
+#endif
+    case Kernel::SCALAR:
+        runScalar(pass);
+        break;
+    }
+    pass.finish(r);
+}
+
+
+srh::Prio srh::findNeedle(Kernel kernel,
+        std::u8string_view prepared, std::span<const HayWord> words,
+        const Needle& needle, HaystackClass hclass, Classifier cls)
+{
+    static constexpr size_t N_LOCAL = 16;
+    Place localPlaces[N_LOCAL];
+    SafeVector<Place> bigPlaces;
+    std::span<Place> places;
+    if (needle.words.size() <= N_LOCAL) {
+        places = std::span{ localPlaces, needle.words.size() };
+    } else {
+        bigPlaces.resize(needle.words.size());
+        places = bigPlaces;
+    }
+    findPlaces(kernel, prepared, words, needle, hclass, places, cls);
+
+    srh::Prio r;
+    for (auto v : places) {
+        switch (v) {
+        case Place::EXACT: ++r.exact; break;
+        case Place::EXACT_SCRIPT: ++r.exactScript; break;
+        case Place::INITIAL: ++r.initial; break;
+        case Place::INITIAL_SRIPT: ++r.initialScript; break;
+        case Place::PARTIAL: ++r.partial; break;
+        case Place::FUZZY: ++r.fuzzy; break;
+        case Place::NONE: ;
+        }
+    }
+    return r;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+///
+/// Vectorized multi-needle matcher over prepared haystack
+///
+
+// STL
+#include <span>
+
+// Libs
+#include "u_EnumSize.h"
+
+// Search
+#include "engine.h"
+
+namespace srh {
+
+    DEFINE_ENUM_TYPE_IN_NS(srh, Kernel, unsigned char,
+        SCALAR,     ///< std::u8string_view::find
+        SSE2,       ///< 16 bytes at once
+        AVX2)       ///< 32 bytes at once
+
+    /// Haystack should have so many readable bytes after its end
+    constexpr size_t MATCHER_PADDING = 32;
+
+    /// @return [+] kernel can run on this machine
+    bool isSupported(Kernel kernel);
+    /// @return the fastest supported kernel for Unicode names
+    Kernel bestKernel();
+
+    /// Same as findWord for every needle word, in one pass over haystack
+    /// @param [in] prepared  haystack prepared by Comparator,
+    ///                  MATCHER_PADDING readable bytes after it
+    /// @param [in] words  its words, as splitWords gives (w/o empty),
+    ///                  should point inside prepared
+    /// @param [out] r   place of every needle word
+    /// @param [in] cls  what’s before word start: classify for English names,
+    ///                  classifyFolded for localized ones
+    /// @pre  r.size() == needle.words.size()
+    void findPlaces(Kernel kernel,
+                    std::u8string_view prepared, std::span<const HayWord> words,
+                    const Needle& needle, HaystackClass hclass, std::span<Place> r,
+                    Classifier cls = classify);
+
+    /// Same as findNeedle, but using findPlaces
+    Prio findNeedle(Kernel kernel,
+                    std::u8string_view prepared, std::span<const HayWord> words,
+                    const Needle& needle, HaystackClass hclass,
+                    Classifier cls = classify);
+
+}   // namespace srh
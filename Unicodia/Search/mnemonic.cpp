@@ -0,0 +1,38 @@
+// My header
+#include "mnemonic.h"
+
+// Libs
+#include "u_Strings.h"
+
+
+void srh::MnemonicIndex::add(HayId id, uint16_t iName, std::u8string_view mnemonic)
+{
+    exact[mnemonic].push_back({ id, iName });
+    folded[lat::toUpper(mnemonic)].push_back({ id, iName });
+    ++fSize;
+}
+
+
+void srh::MnemonicIndex::find(std::u8string_view mnemonic, SafeVector<Hit>& r) const
+{
+    r.clear();
+    static const SafeVector<Entry> NO_ENTRIES;
+    auto itExact = exact.find(mnemonic);
+    auto& exactEntries = (itExact != exact.end()) ? itExact->second : NO_ENTRIES;
+    auto itFolded = folded.find(lat::toUpper(mnemonic));
+    auto& foldedEntries = (itFolded != folded.end()) ? itFolded->second : NO_ENTRIES;
+
+    // Both lists go in ascending ID order, and exact ⊂ folded → merge them
+    auto pExact = exactEntries.begin();
+    for (auto& v : foldedEntries) {
+        if (!r.empty() && r.back().id == v.id)
+            continue;   // The same haystack once again
+        while (pExact != exactEntries.end() && pExact->id < v.id)
+            ++pExact;
+        if (pExact != exactEntries.end() && pExact->id == v.id) {
+            r.push_back({ .id = v.id, .iName = pExact->iName, .isExact = true });
+        } else {
+            r.push_back({ .id = v.id, .iName = v.iName, .isExact = false });
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+///
+/// Hash index for HTML mnemonics: &amp; → haystacks
+///
+
+// STL
+#include <string>
+#include <unordered_map>
+
+// Libs
+#include "u_Vector.h"
+
+// Search
+#include "index.h"
+
+namespace srh {
+
+    ///
+    ///  Exact and case-folded (A…Z only) maps mnemonic → haystacks.
+    ///
+    ///  Usage: add all mnemonics in ascending ID order, then search.
+    ///  Mnemonics are stored as views and should live as long as index.
+    ///
+    class MnemonicIndex
+    {
+    public:
+        struct Hit {
+            HayId id;
+            uint16_t iName;     ///< as was given to add
+            bool isExact;       ///< [+] case-sensitive match
+        };
+
+        void add(HayId id, uint16_t iName, std::u8string_view mnemonic);
+
+        /// Finds every haystack where mnemonic is present,
+        ///   exact matches win over case-insensitive ones of the same haystack
+        /// @param [in] mnemonic  with & and ;
+        /// @param [out] r  one hit per haystack, in ascending ID order
+        void find(std::u8string_view mnemonic, SafeVector<Hit>& r) const;
+
+        bool isEmpty() const { return exact.empty(); }
+        size_t size() const { return fSize; }
+    private:
+        struct Entry {
+            HayId id;
+            uint16_t iName;
+        };
+        std::unordered_map<std::u8string_view, SafeVector<Entry>> exact;
+        std::unordered_map<std::u8string, SafeVector<Entry>> folded;
+        size_t fSize = 0;
+    };
+
+}   // namespace srh
@@ -3,7 +3,6 @@
 
 // STL
 #include <unordered_map>
-#include <memory>
 
 // Strings
 #include "u_Strings.h"
@@ -16,10 +15,6 @@ namespace {
 
     using M = std::unordered_map<char32_t, char>;
 
-    /// Somehow reentrant; fighting for object and making 2+ is OK
-    /// (though we do not use threads and it won’t happen)
-    std::unique_ptr<M> NON_ASCII_MAP;
-
     constinit std::initializer_list<M::value_type> NON_ASCII_INIT {
         { U'°', '*' },
         // All Latin-1 letters regardless of whether they pre present
@@ -183,6 +178,14 @@ namespace {
         // 3009 = 〉 (instead of deprecated)
     };
 
+    /// Lazy big object initialization
+    /// Thread-safe: search runs in a separate thread
+    const M& nonAsciiMap()
+    {
+        static const M map(NON_ASCII_INIT);
+        return map;
+    }
+
 }   // anon namespace
 
 void srh::NonAsciiComparator::prepareHaystack(
@@ -193,12 +196,9 @@ void srh::NonAsciiComparator::prepareHaystack(
         if (x < 128) {
             result.push_back(lat::toUpper(x));
         } else {
-            // Lazy big object initialization
-            if (!NON_ASCII_MAP) {
-                NON_ASCII_MAP = std::make_unique<M>(NON_ASCII_INIT);
-            }
-            auto res = NON_ASCII_MAP->find(x);
-            if (res != NON_ASCII_MAP->end()) {
+            auto& map = nonAsciiMap();
+            auto res = map.find(x);
+            if (res != map.end()) {
                 result.push_back(lat::toUpper(res->second));
             } else {
                 // otherwise do nothing?
@@ -0,0 +1,462 @@
+// My header
+#include "pattern.h"
+
+// STL
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+// Libs
+#include "u_Strings.h"
+
+namespace {
+
+    using CharSet = std::bitset<256>;
+    constexpr uint32_t NO_STATE = 0xFFFF'FFFF;
+
+    ///
+    ///  Thompson NFA: state is either “char of set → next”,
+    ///  or up to two ε-transitions
+    ///
+    struct NfaState {
+        uint32_t iSet = NO_STATE;   ///< char set, NO_STATE = ε-only state
+        uint32_t next = NO_STATE;
+        uint32_t eps[2] { NO_STATE, NO_STATE };
+    };
+
+    /// Piece of NFA; end has no transitions until joined
+    struct Frag {
+        uint32_t start, end;
+    };
+
+    class Nfa
+    {
+    public:
+        SafeVector<NfaState> states;
+        SafeVector<CharSet> sets;
+
+        uint32_t newState();
+        void addEps(uint32_t from, uint32_t to);
+
+        Frag empty();
+        Frag chars(const CharSet& set);
+        Frag anyChar() { return chars(CharSet{}.set()); }
+        Frag cat(Frag a, Frag b);
+        Frag alt(Frag a, Frag b);
+        Frag star(Frag a);
+        Frag plus(Frag a);
+        Frag question(Frag a);
+    };
+
+    uint32_t Nfa::newState()
+    {
+        states.emplace_back();
+        return states.size() - 1;
+    }
+
+    void Nfa::addEps(uint32_t from, uint32_t to)
+    {
+        auto& st = states[from];
+        // By construction we never need more than two
+        st.eps[st.eps[0] == NO_STATE ? 0 : 1] = to;
+    }
+
+    Frag Nfa::empty()
+    {
+        auto s = newState();
+        return { s, s };
+    }
+
+    Frag Nfa::chars(const CharSet& set)
+    {
+        auto s = newState();
+        auto e = newState();
+        states[s].iSet = sets.size();
+        states[s].next = e;
+        sets.push_back(set);
+        return { s, e };
+    }
+
+    Frag Nfa::cat(Frag a, Frag b)
+    {
+        addEps(a.end, b.start);
+        return { a.start, b.end };
+    }
+
+    Frag Nfa::alt(Frag a, Frag b)
+    {
+        auto s = newState();
+        auto e = newState();
+        addEps(s, a.start);
+        addEps(s, b.start);
+        addEps(a.end, e);
+        addEps(b.end, e);
+        return { s, e };
+    }
+
+    Frag Nfa::star(Frag a)
+    {
+        auto s = newState();
+        auto e = newState();
+        addEps(s, a.start);
+        addEps(s, e);
+        addEps(a.end, a.start);
+        addEps(a.end, e);
+        return { s, e };
+    }
+
+    Frag Nfa::plus(Frag a)
+    {
+        auto e = newState();
+        addEps(a.end, a.start);
+        addEps(a.end, e);
+        return { a.start, e };
+    }
+
+    Frag Nfa::question(Frag a)
+    {
+        auto s = newState();
+        auto e = newState();
+        addEps(s, a.start);
+        addEps(s, e);
+        addEps(a.end, e);
+        return { s, e };
+    }
+
+    ///// Parsers //////////////////////////////////////////////////////////////
+
+    Frag parseWildcard(Nfa& nfa, std::u8string_view s)
+    {
+        Frag r = nfa.empty();
+        for (auto c : s) {
+            switch (c) {
+            case '*':
+                r = nfa.cat(r, nfa.star(nfa.anyChar()));
+                break;
+            case '?':
+                r = nfa.cat(r, nfa.anyChar());
+                break;
+            default:
+                r = nfa.cat(r, nfa.chars(CharSet{}.set(static_cast<unsigned char>(c))));
+            }
+        }
+        return r;
+    }
+
+    ///  Recursive descent: alt ::= concat (| concat)*,
+    ///  concat ::= repeat*,  repeat ::= atom [*+?]*
+    class RegexParser
+    {
+    public:
+        RegexParser(Nfa& aNfa, std::u8string_view aS) : nfa(aNfa), s(aS) {}
+        /// @return [+] whole string parsed
+        bool run(Frag& r);
+    private:
+        static constexpr unsigned MAX_DEPTH = 100;
+        Nfa& nfa;
+        std::u8string_view s;
+        size_t pos = 0;
+        unsigned depth = 0;
+        bool isOk = true;
+
+        bool isEnd() const { return (pos >= s.length()); }
+        unsigned char peek() const { return s[pos]; }
+        Frag fail() { isOk = false; return nfa.empty(); }
+
+        Frag parseAlt();
+        Frag parseConcat();
+        Frag parseRepeat();
+        Frag parseAtom();
+        Frag parseClass();
+        /// Char of [class], maybe escaped
+        bool parseClassChar(unsigned char& r);
+    };
+
+    bool RegexParser::run(Frag& r)
+    {
+        r = parseAlt();
+        return isOk && isEnd();
+    }
+
+    Frag RegexParser::parseAlt()
+    {
+        if (++depth > MAX_DEPTH)
+            return fail();
+        Frag r = parseConcat();
+        while (isOk && !isEnd() && peek() == '|') {
+            ++pos;
+            r = nfa.alt(r, parseConcat());
+        }
+        --depth;
+        return r;
+    }
+
+    Frag RegexParser::parseConcat()
+    {
+        Frag r = nfa.empty();
+        while (isOk && !isEnd() && peek() != '|' && peek() != ')')
+            r = nfa.cat(r, parseRepeat());
+        return r;
+    }
+
+    Frag RegexParser::parseRepeat()
+    {
+        Frag r = parseAtom();
+        while (isOk && !isEnd()) {
+            switch (peek()) {
+            case '*': r = nfa.star(r); break;
+            case '+': r = nfa.plus(r); break;
+            case '?': r = nfa.question(r); break;
+            default: return r;
+            }
+            ++pos;
+        }
+        return r;
+    }
+
+    Frag RegexParser::parseAtom()
+    {
+        auto c = peek();
+        ++pos;
+        switch (c) {
+        case '(': {
+                Frag r = parseAlt();
+                if (!isOk || isEnd() || peek() != ')')
+                    return fail();
+                ++pos;
+                return r;
+            }
+        case '[':
+            return parseClass();
+        case '.':
+            return nfa.anyChar();
+        case '\\':
+            if (isEnd())
+                return fail();
+            return nfa.chars(CharSet{}.set(static_cast<unsigned char>(s[pos++])));
+        case '*':   // Nothing to repeat
+        case '+':
+        case '?':
+        case '^':   // Anchors are at the ends only
+        case '$':
+            return fail();
+        default:
+            return nfa.chars(CharSet{}.set(c));
+        }
+    }
+
+    bool RegexParser::parseClassChar(unsigned char& r)
+    {
+        if (isEnd())
+            return false;
+        r = peek();
+        ++pos;
+        if (r == '\\') {
+            if (isEnd())
+                return false;
+            r = peek();
+            ++pos;
+        }
+        return true;
+    }
+
+    Frag RegexParser::parseClass()
+    {
+        CharSet set;
+        bool isNegative = false;
+        if (!isEnd() && peek() == '^') {
+            isNegative = true;
+            ++pos;
+        }
+        while (true) {
+            if (isEnd())
+                return fail();
+            if (peek() == ']') {
+                ++pos;
+                break;
+            }
+            unsigned char c1, c2;
+            if (!parseClassChar(c1))
+                return fail();
+            c2 = c1;
+            if (pos + 1 < s.length() && peek() == '-' && s[pos + 1] != ']') {
+                ++pos;
+                if (!parseClassChar(c2) || c2 < c1)
+                    return fail();
+            }
+            for (unsigned c = c1; c <= c2; ++c)
+                set.set(c);
+        }
+        if (isNegative)
+            set.flip();
+        if (set.none())
+            return fail();
+        return nfa.chars(set);
+    }
+
+    ///// DFA building /////////////////////////////////////////////////////////
+
+    void closeOver(const Nfa& nfa, SafeVector<uint32_t>& set, SafeVector<char>& isIn)
+    {
+        for (auto v : set)
+            isIn[v] = true;
+        // set is used as DFS stack too
+        for (size_t i = 0; i < set.size(); ++i) {
+            for (auto e : nfa.states[set[i]].eps) {
+                if (e != NO_STATE && !isIn[e]) {
+                    isIn[e] = true;
+                    set.push_back(e);
+                }
+            }
+        }
+        for (auto v : set)
+            isIn[v] = false;
+        std::sort(set.begin(), set.end());
+    }
+
+}   // anon namespace
+
+
+void srh::Pattern::clear()
+{
+    classOf.fill(0);
+    fNClasses = 1;
+    start = DEAD;
+    trans.assign(1, DEAD);
+    isFinal.assign(1, false);
+    isSure.assign(1, false);
+}
+
+
+srh::PatternStatus srh::Pattern::compile(std::u8string_view x, PatternSyntax syntax)
+{
+    clear();
+    if (x.length() > MAX_LENGTH)
+        return PatternStatus::TOO_COMPLEX;
+    std::u8string upper { x };
+    str::toUpperInPlace(upper);
+    std::u8string_view s = upper;
+
+    // Parse
+    Nfa nfa;
+    Frag frag;
+    switch (syntax) {
+    case PatternSyntax::WILDCARD:
+        frag = parseWildcard(nfa, s);
+        break;
+    case PatternSyntax::REGEX: {
+            bool isAnchoredStart = s.starts_with('^');
+            if (isAnchoredStart)
+                s.remove_prefix(1);
+            // $ at end, but not \$
+            bool isAnchoredEnd = false;
+            if (s.ends_with('$')) {
+                auto body = s.substr(0, s.length() - 1);
+                auto iLast = body.find_last_not_of('\\');
+                size_t nSlashes = body.length()
+                        - ((iLast == std::u8string_view::npos) ? 0 : iLast + 1);
+                if (nSlashes % 2 == 0) {
+                    isAnchoredEnd = true;
+                    s = body;
+                }
+            }
+            RegexParser parser(nfa, s);
+            if (!parser.run(frag))
+                return PatternStatus::SYNTAX;
+            if (!isAnchoredStart)
+                frag = nfa.cat(nfa.star(nfa.anyChar()), frag);
+            if (!isAnchoredEnd)
+                frag = nfa.cat(frag, nfa.star(nfa.anyChar()));
+        } break;
+    }
+
+    // Alphabet: bytes that are in the same sets are equivalent
+    std::array<uint8_t, 256> newClassOf;
+    unsigned nClasses = 1;
+    for (auto& set : nfa.sets) {
+        std::array<int, 512> remap;
+        remap.fill(-1);
+        unsigned newN = 0;
+        for (unsigned b = 0; b < 256; ++b) {
+            auto& slot = remap[classOf[b] * 2 + set[b]];
+            if (slot < 0)
+                slot = newN++;
+            newClassOf[b] = slot;
+        }
+        classOf = newClassOf;
+        nClasses = newN;
+    }
+    std::array<uint8_t, 256> representative {};
+    for (unsigned b = 256; b-- > 0; )
+        representative[classOf[b]] = b;
+
+    // Subset construction; state 0 is dead = empty set
+    SafeVector<SafeVector<uint32_t>> dfaSets { {} };
+    std::map<SafeVector<uint32_t>, State> known { { {}, DEAD } };
+    SafeVector<char> isIn(nfa.states.size(), false);
+    SafeVector<uint32_t> set { frag.start };
+    closeOver(nfa, set, isIn);
+    known.emplace(set, 1);
+    dfaSets.push_back(std::move(set));
+
+    SafeVector<State> newTrans(nClasses, DEAD);
+    for (size_t i = 1; i < dfaSets.size(); ++i) {
+        for (unsigned c = 0; c < nClasses; ++c) {
+            const auto b = representative[c];
+            set.clear();
+            for (auto v : dfaSets[i]) {
+                auto& st = nfa.states[v];
+                if (st.iSet != NO_STATE && nfa.sets[st.iSet][b])
+                    set.push_back(st.next);
+            }
+            closeOver(nfa, set, isIn);
+            auto [it, isNew] = known.try_emplace(set, static_cast<State>(dfaSets.size()));
+            if (isNew) {
+                if (dfaSets.size() >= MAX_STATES) {
+                    clear();
+                    return PatternStatus::TOO_COMPLEX;
+                }
+                dfaSets.push_back(set);
+            }
+            newTrans.push_back(it->second);
+        }
+    }
+
+    // Final states, and sure ones: final whatever follows
+    const size_t n = dfaSets.size();
+    isFinal.assign(n, false);
+    for (size_t i = 0; i < n; ++i)
+        isFinal[i] = std::binary_search(dfaSets[i].begin(), dfaSets[i].end(), frag.end);
+    isSure = isFinal;
+    for (bool isChanged = true; isChanged; ) {
+        isChanged = false;
+        for (size_t i = 0; i < n; ++i) {
+            if (!isSure[i])
+                continue;
+            auto row = newTrans.begin() + i * nClasses;
+            if (std::any_of(row, row + nClasses, [this](State x) { return !isSure[x]; })) {
+                isSure[i] = false;
+                isChanged = true;
+            }
+        }
+    }
+
+    fNClasses = nClasses;
+    trans = std::move(newTrans);
+    start = 1;
+    return PatternStatus::OK;
+}
+
+
+bool srh::Pattern::matches(std::u8string_view s) const
+{
+    State q = start;
+    for (auto c : s) {
+        if (isSure[q])
+            return true;
+        q = trans[q * fNClasses + classOf[static_cast<unsigned char>(c)]];
+        if (q == DEAD)
+            return false;
+    }
+    return isFinal[q];
+}
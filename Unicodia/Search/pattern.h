@@ -0,0 +1,65 @@
+#pragma once
+
+///
+/// Wildcard and regex search over prepared names, compiled to DFA
+///
+
+// STL
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Libs
+#include "u_Vector.h"
+
+namespace srh {
+
+    enum class PatternSyntax : unsigned char {
+        WILDCARD,   ///< LATIN * LETTER ? WITH HOOK: * = any, ? = one char, whole name
+        REGEX       ///< ^CJK.*RADICAL: anywhere in name unless anchored by ^ $
+    };
+
+    enum class PatternStatus : unsigned char {
+        OK,
+        SYNTAX,         ///< bad pattern
+        TOO_COMPLEX     ///< DFA would be too big
+    };
+
+    ///
+    ///  Pattern compiled once to DFA, then checked against prepared
+    ///  (uppercased) names in linear time, whatever the pattern is.
+    ///
+    ///  Regex: literals, \ escapes, . [A-Z] [^…] ( | ) * + ?,
+    ///    ^ at start and $ at end only.
+    ///  Works on UTF-8 bytes: non-ASCII chars go literally,
+    ///    . and ? mean one byte.
+    ///
+    class Pattern
+    {
+    public:
+        /// Longer patterns are surely not typed by hand
+        static constexpr size_t MAX_LENGTH = 1000;
+        static constexpr size_t MAX_STATES = 2000;
+
+        /// Upper-cases pattern and compiles it
+        /// @return  status; on error pattern matches nothing
+        PatternStatus compile(std::u8string_view x, PatternSyntax syntax);
+
+        bool matches(std::u8string_view s) const;
+        size_t nStates() const { return isFinal.size(); }
+        size_t nClasses() const { return fNClasses; }
+    private:
+        using State = uint16_t;
+        static constexpr State DEAD = 0;    ///< never leaves, never matches
+
+        std::array<uint8_t, 256> classOf {};    ///< byte → equivalence class
+        unsigned fNClasses = 1;
+        State start = DEAD;
+        SafeVector<State> trans;                ///< [state * nClasses + class]
+        SafeVector<bool> isFinal { false };
+        SafeVector<bool> isSure { false };      ///< [+] final whatever follows
+
+        void clear();
+    };
+
+}   // namespace srh
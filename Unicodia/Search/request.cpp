@@ -1,6 +1,9 @@
 // My header
 #include "request.h"
 
+// STL
+#include <mutex>
+
 namespace {
 
     struct EmojiState {
@@ -43,15 +46,21 @@ uc::MultiResult uc::doRequest(const Request& rq)
     if (rq.hasChars()) {
         const uc::Block* oldBlock = nullptr;
         uc::SearchGroup* lastGroup = nullptr;
-        for (const auto& cp : uc::cpInfo) {
-            if (rq.isOk(cp)) {
-                auto* newBlock = &cp.block();
-                if (newBlock != oldBlock) {
-                    lastGroup = &r.groups.emplace_back();
-                    lastGroup->obj = newBlock;
-                    oldBlock = newBlock;
-                }
-                lastGroup->lines.emplace_back(cp);
+        auto addCp = [&](const uc::Cp& cp) {
+            auto* newBlock = &cp.block();
+            if (newBlock != oldBlock) {
+                lastGroup = &r.groups.emplace_back();
+                lastGroup->obj = newBlock;
+                oldBlock = newBlock;
+            }
+            lastGroup->lines.emplace_back(cp);
+        };
+        if (srh::RunBitmap chars; rq.findChars(chars)) {
+            chars.forEach([&addCp](srh::HayId i) { addCp(uc::cpInfo[i]); });
+        } else {
+            for (const auto& cp : uc::cpInfo) {
+                if (rq.isOk(cp))
+                    addCp(cp);
             }
         }
     }
@@ -74,9 +83,79 @@ namespace {
     inline bool isIneq(Ec inFields, Ec inCp)
         { return (inFields != Ec::NO_VALUE && inFields != inCp); }
 
+    template <class Ec>
+    constexpr size_t nValues() { return static_cast<size_t>(Ec::NN); }
+
+    constexpr size_t N_FLAG_BITS = sizeof(uc::Cfgs::Storage) * 8;
+    /// Changed at runtime, and cannot be indexed
+    constexpr uc::Cfgs DYNAMIC_FLAGS = uc::Cfg::DYN_SYSTEM_TOFU;
+
+    ///
+    ///  Property → characters (indexes in cpInfo)
+    ///
+    struct PropIndex {
+        srh::RunBitmap versions[nValues<uc::EcVersion>()];
+        srh::RunBitmap scripts[nValues<uc::EcScript>()];
+        srh::RunBitmap categories[nValues<uc::EcCategory>()];
+        srh::RunBitmap upCats[nValues<uc::EcUpCategory>()];
+        srh::RunBitmap bidiClasses[nValues<uc::EcBidiClass>()];
+        srh::RunBitmap flags[N_FLAG_BITS];
+        srh::RunBitmap numbers;
+
+        void build();
+    };
+
+    void PropIndex::build()
+    {
+        for (srh::HayId i = 0; i < uc::N_CPS; ++i) {
+            auto& cp = uc::cpInfo[i];
+            versions[static_cast<size_t>(cp.ecVersion)].add(i);
+            scripts[static_cast<size_t>(cp.ecScript)].add(i);
+            categories[static_cast<size_t>(cp.ecCategory)].add(i);
+            upCats[static_cast<size_t>(cp.category().upCat)].add(i);
+            bidiClasses[static_cast<size_t>(cp.ecBidiClass)].add(i);
+            for (size_t iBit = 0; iBit < N_FLAG_BITS; ++iBit) {
+                if (cp.flags.numeric() & (1u << iBit))
+                    flags[iBit].add(i);
+            }
+            if (cp.numeric().isPresent())
+                numbers.add(i);
+        }
+    }
+
+    PropIndex propIndex;
+    std::once_flag propIndexOnce;
+
+    const PropIndex& ensurePropIndex()
+    {
+        std::call_once(propIndexOnce, [] { propIndex.build(); });
+        return propIndex;
+    }
+
+    template <class Ec, size_t N>
+    inline void andIf(srh::RunBitmap& r, const srh::RunBitmap (&index)[N], Ec inFields)
+    {
+        if (inFields == Ec::NO_VALUE)
+            return;
+        if (auto i = static_cast<size_t>(inFields); i < N) {
+            r &= index[i];
+        } else {
+            r = {};     // No chars have it
+        }
+    }
+
 }   // anon namespace
 
 
+const srh::RunBitmap& uc::charsOfScript(EcScript x)
+{
+    static const srh::RunBitmap EMPTY;
+    auto& index = ensurePropIndex();
+    auto i = static_cast<size_t>(x);
+    return (i < std::size(index.scripts)) ? index.scripts[i] : EMPTY;
+}
+
+
 bool uc::CharFieldRequest::isOk(const Cp& cp) const
 {
     // Version
@@ -106,6 +185,62 @@ bool uc::CharFieldRequest::isOk(const Cp& cp) const
 }
 
 
+///  Dynamic flags are not indexed: narrows by some hot column,
+///  then checks the rest
+bool uc::CharFieldRequest::scanChars(srh::RunBitmap& r) const
+{
+    r = {};
+    auto addIfOk = [this, &r](srh::HayId i) {
+        if (isOk(uc::cpInfo[i]))
+            r.add(i);
+    };
+    auto eq = [](auto value) {
+        return [value](decltype(value) x) { return x == value; };
+    };
+    if (fields.ecScript != EcScript::NO_VALUE) {
+        uc::scanColumn(uc::cpScripts, eq(fields.ecScript), addIfOk);
+    } else if (fields.ecVersion != EcVersion::NO_VALUE) {
+        uc::scanColumn(uc::cpVersions, eq(fields.ecVersion), addIfOk);
+    } else if (fields.ecCategory != EcCategory::NO_VALUE) {
+        uc::scanColumn(uc::cpCategories, eq(fields.ecCategory), addIfOk);
+    } else if (fields.ecBidiClass != EcBidiClass::NO_VALUE) {
+        uc::scanColumn(uc::cpBidiClasses, eq(fields.ecBidiClass), addIfOk);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+bool uc::CharFieldRequest::findChars(srh::RunBitmap& r) const
+{
+    if (fields.fgs.haveAny(DYNAMIC_FLAGS))
+        return scanChars(r);
+    auto& index = ensurePropIndex();
+    r = srh::RunBitmap::all(uc::N_CPS);
+    andIf(r, index.versions, fields.ecVersion);
+    andIf(r, index.scripts, fields.ecScript);
+    if (fields.ecCategory != EcCategory::NO_VALUE) {
+        andIf(r, index.categories, fields.ecCategory);
+    } else {
+        andIf(r, index.upCats, fields.ecUpCat);
+    }
+    andIf(r, index.bidiClasses, fields.ecBidiClass);
+    // Flags: any of them
+    if (fields.fgs) {
+        srh::RunBitmap withFlags;
+        for (size_t iBit = 0; iBit < N_FLAG_BITS; ++iBit) {
+            if (fields.fgs.numeric() & (1u << iBit))
+                withFlags |= index.flags[iBit];
+        }
+        r &= withFlags;
+    }
+    if (fields.isNumber)
+        r &= index.numbers;
+    return true;
+}
+
+
 uc::PrimaryObj uc::CharFieldRequest::primaryObj() const
 {
     // Checks for future remakes
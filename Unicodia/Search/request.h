@@ -4,6 +4,9 @@
 #include "Search/uc.h"
 #include "UcData.h"
 
+// Search
+#include "bitmap.h"
+
 namespace uc {
 
     class Request   // interface
@@ -24,6 +27,10 @@ namespace uc {
 
         /// @return [+] character is within request
         virtual bool isOk(const Cp& cp) const = 0;
+        /// Quick way of finding characters, w/o calling isOk for each
+        /// @param [out] r   indexes in cpInfo where isOk
+        /// @return [+] r is found  [-] no quick way, check isOk
+        virtual bool findChars(srh::RunBitmap&) const { return false; }
         /// @return [+] emoji is within request
         virtual bool isOk(const uc::LibNode&) const { return false; }
         ~Request() = default;
@@ -31,6 +38,9 @@ namespace uc {
 
     MultiResult doRequest(const Request& rq);
 
+    /// @return  indexes in cpInfo of script’s chars, from property index
+    const srh::RunBitmap& charsOfScript(EcScript x);
+
     struct CharFields {
         uc::EcScript ecScript = uc::EcScript::NO_VALUE;
         uc::EcVersion ecVersion = uc::EcVersion::NO_VALUE;        
@@ -49,9 +59,11 @@ namespace uc {
         bool hasChars() const override { return true; }
         EcVersion ecVersion() const override { return fields.ecVersion; }
         bool isOk(const Cp& cp) const override;
+        bool findChars(srh::RunBitmap& r) const override;
         PrimaryObj primaryObj() const override;
     private:
         CharFields fields;
+        bool scanChars(srh::RunBitmap& r) const;
     };
 
     struct EmojiFields {
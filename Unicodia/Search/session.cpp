@@ -0,0 +1,74 @@
+// My header
+#include "session.h"
+
+// STL
+#include <algorithm>
+
+
+void srh::Session::clear()
+{
+    words.clear();
+    candidates.reset(0);
+}
+
+
+bool srh::Session::isRefinement(const Needle& needle) const
+{
+    if (words.empty() || needle.words.empty())
+        return false;
+    // Fuzzy words are not substrings of needle words
+    if (std::any_of(needle.words.begin(), needle.words.end(),
+            [](const NeedleWord& nw) { return !nw.fuzzyWords.empty(); }))
+        return false;
+    return std::all_of(needle.words.begin(), needle.words.end(),
+        [this](const NeedleWord& nw) {
+            return std::any_of(words.begin(), words.end(),
+                [&nw](const std::u8string& old) {
+                    return (nw.sv().find(old) != std::u8string_view::npos);
+                });
+        });
+}
+
+
+bool srh::Session::hasAnyWord(
+        const HayArena& arena, HayId id, const Needle& needle)
+{
+    for (auto& nm : arena.names(id)) {
+        if (!nm.isIndexed())
+            continue;
+        for (auto& hw : arena.words(nm)) {
+            for (auto& nw : needle.words) {
+                if (hw.sv().find(nw.sv()) != std::u8string_view::npos)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+bool srh::Session::findCandidates(
+        const HayArena& arena, const WordIndex& index,
+        const Needle& needle, IdSet& r)
+{
+    bool isRefined = isRefinement(needle)
+            && (candidates.capacity() == index.nIds());
+    if (isRefined) {
+        IdSet newCandidates;
+        newCandidates.reset(index.nIds());
+        candidates.forEach([&](HayId id) {
+            if (hasAnyWord(arena, id, needle))
+                newCandidates.add(id);
+        });
+        candidates = std::move(newCandidates);
+    } else {
+        candidates.reset(index.nIds());
+        index.findCandidates(needle, candidates);
+    }
+
+    words.clear();
+    for (auto& nw : needle.words)
+        words.push_back(nw.v);
+    r = candidates;
+    return isRefined;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+///
+/// Search session: search-as-you-type refines previous results
+///
+
+// Libs
+#include "u_Vector.h"
+
+// Search
+#include "arena.h"
+
+namespace srh {
+
+    ///
+    ///  Keeps needle words and candidates of previous search.
+    ///
+    ///  Refinement: every new needle word contains some old one as substring
+    ///  (lat → lati → latin). Then new candidates are subset of old ones,
+    ///  and we just filter them. New words (latin → latin capital)
+    ///  widen candidates, as any word is enough → search from scratch.
+    ///
+    class Session
+    {
+    public:
+        /// Same as WordIndex::findCandidates, but refines previous candidates
+        ///   when possible
+        /// @return [+] refined [-] searched from scratch
+        bool findCandidates(const HayArena& arena, const WordIndex& index,
+                            const Needle& needle, IdSet& r);
+        /// Forgets previous search, say after rebuilding index
+        void clear();
+        bool isEmpty() const { return words.empty(); }
+    private:
+        SafeVector<std::u8string> words;
+        IdSet candidates;
+
+        bool isRefinement(const Needle& needle) const;
+        static bool hasAnyWord(const HayArena& arena, HayId id, const Needle& needle);
+    };
+
+}   // namespace srh
@@ -0,0 +1,40 @@
+#pragma once
+
+///
+/// Simple parallel run of sharded work
+///
+
+// STL
+#include <algorithm>
+#include <thread>
+
+// Libs
+#include "u_Vector.h"
+
+namespace srh {
+
+    /// @return  # of shards for nItems items, ≥1
+    /// @param [in] minPerShard  smaller shards are not worth a thread
+    inline size_t nShardsFor(size_t nItems, size_t minPerShard)
+    {
+        constexpr size_t MAX_SHARDS = 16;
+        size_t nThreads = std::clamp<size_t>(
+                std::thread::hardware_concurrency(), 1, MAX_SHARDS);
+        return std::clamp<size_t>(nItems / minPerShard, 1, nThreads);
+    }
+
+    /// Runs body(iShard) for shards [0..nShards), last one in calling thread
+    /// @warning  body should be thread-safe
+    template <class Body>
+    void runShards(size_t nShards, const Body& body)
+    {
+        {   SafeVector<std::jthread> threads;
+            threads.reserve(nShards);
+            for (size_t i = 0; i + 1 < nShards; ++i)
+                threads.emplace_back([&body, i] { body(i); });
+            if (nShards != 0)
+                body(nShards - 1);
+        }   // jthread’s dtor joins
+    }
+
+}   // namespace srh
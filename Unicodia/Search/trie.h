@@ -1,6 +1,10 @@
 #pragma once
 
 // STL
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <unordered_map>
 #include <memory>
 
@@ -36,6 +40,10 @@ namespace srh {
 
         inline const TrieNode* unsafeFind(char32_t c) const;
         const TrieNode* find(char32_t c) const;
+
+        /// Traverses children in arbitrary order
+        template <class Body>
+        void forEachChild(const Body& body) const;
     protected:
         R fResult {};
         using M = std::unordered_map<char32_t, TrieNode>;
@@ -64,8 +72,105 @@ namespace srh {
                 add(sv, res);
             }
         SafeVector<Decoded<R>> decode(std::u32string_view s) const;
+
+        // For decode
+        const Node* rootNode() const { return this; }
+        static const Node* findChild(const Node* p, char32_t c) { return p->find(c); }
     };
 
+    ///
+    ///  Read-only trie made of TrieRoot: nodes go breadth-first in one buffer,
+    ///  children of each node are contiguous and sorted by char.
+    ///  Root’s children are also a bitmap: most chars of pasted text
+    ///  are not emoji starts.
+    ///
+    template <Result R>
+    class CompactTrie
+    {
+    public:
+        static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+        class Node {
+        public:
+            const R& result() const { return fResult; }
+            bool isFinal() const { return fIsFinal; }
+            unsigned depth() const { return fDepth; }
+        private:
+            friend class CompactTrie;
+            R fResult {};
+            uint32_t iFirstChild = 0, nChildren = 0;
+            uint16_t fDepth = 0;
+            bool fIsFinal = false;
+        };
+
+        /// Makes empty trie (root only)
+        CompactTrie() : nodes(1), keys(1) {}
+        explicit CompactTrie(const TrieRoot<R>& x);
+
+        const Node* rootNode() const { return nodes.data(); }
+        /// @return  child of p that goes by c, or null
+        const Node* findChild(const Node* p, char32_t c) const;
+        size_t nNodes() const { return nodes.size(); }
+
+        /// Exactly the same as TrieRoot::decode, backing off included,
+        ///   in one pass over s: after backing off we re-read
+        ///   less than maxDepth chars, kept by Decoder
+        SafeVector<Decoded<R>> decode(std::u32string_view s) const;
+
+        ///
+        ///  Streaming decode, the same as decode(): chars come one by one
+        ///  (say, long text is read by chunks), sequences go out as soon
+        ///  as they are known
+        ///
+        class Decoder
+        {
+        public:
+            explicit Decoder(const CompactTrie& aTrie);
+            /// Feeds next char, appends sequences known by now
+            void feed(char32_t c, SafeVector<Decoded<R>>& r);
+            /// End of text, appends the rest
+            void finish(SafeVector<Decoded<R>>& r);
+            /// # of chars fed
+            size_t nFed() const { return iPos; }
+            /// No more sequences start before that position
+            size_t nKnown() const { return iScan - trie->nodes[iNode].fDepth; }
+        private:
+            const CompactTrie* trie;
+            size_t mask;
+            SafeVector<char32_t> chars;     ///< last chars fed, cyclic: we back off by < maxDepth
+            size_t iPos = 0;                ///< # of chars fed
+            size_t iScan = 0;               ///< 1st char not passed yet
+            uint32_t iNode = 0;             ///< where we are in trie
+            uint32_t iLast = NO_NODE;       ///< longest final node on our way
+            size_t iLastEnd = 0;            ///< char after it
+
+            /// Passes char at iScan
+            void step(char32_t c, SafeVector<Decoded<R>>& r);
+            /// Registers iLast, then backs off after it
+            void emitLast(SafeVector<Decoded<R>>& r);
+        };
+    private:
+        SafeVector<Node> nodes;
+        SafeVector<char32_t> keys;      ///< char by which we came to node, parallel to nodes
+        SafeVector<uint64_t> rootBits;  ///< [+] root has such child; most chars have not
+        SafeVector<uint32_t> rootRanks; ///< # of root’s children before rootBits[i]
+        unsigned maxDepth = 0;
+
+        bool isRootKey(char32_t c) const
+        {
+            auto i = c >> 6;
+            return (i < rootBits.size()) && (rootBits[i] & (uint64_t(1) << (c & 63)));
+        }
+        uint32_t childOf(uint32_t iNode, char32_t c) const;
+        /// Same as childOf, root via bitmap
+        uint32_t fastChildOf(uint32_t iNode, char32_t c) const;
+        void buildRoot();
+    };
+
+    namespace detail {
+        template <Result R, class Trie>
+        SafeVector<Decoded<R>> decode(const Trie& trie, std::u32string_view s);
+    }
 
 }
 
@@ -85,6 +190,15 @@ const srh::TrieNode<R>* srh::TrieNode<R>::find(char32_t c) const
     return unsafeFind(c);
 }
 
+template <srh::Result R> template <class Body>
+void srh::TrieNode<R>::forEachChild(const Body& body) const
+{
+    if (children) {
+        for (auto& [c, node] : *children)
+            body(c, node);
+    }
+}
+
 template <srh::Result R>
 inline srh::TrieNode<R>* srh::TrieNode<R>::add(char32_t c)
 {
@@ -107,6 +221,177 @@ void srh::TrieRoot<R>::add(std::u32string_view s, const R& res)
 template <srh::Result R>
 SafeVector<srh::Decoded<R>> srh::TrieRoot<R>::decode(std::u32string_view s) const
 {
+    return detail::decode<R>(*this, s);
+}
+
+template <srh::Result R>
+srh::CompactTrie<R>::CompactTrie(const TrieRoot<R>& x)
+{
+    // Breadth-first: node #i is src[i], its children are appended
+    //   when we reach it, and thus go contiguously
+    using Src = TrieNode<R>;
+    SafeVector<const Src*> src { &x };
+    nodes.resize(1);
+    keys.resize(1);
+    SafeVector<std::pair<char32_t, const Src*>> children;
+    for (size_t i = 0; i < src.size(); ++i) {
+        auto& from = *src[i];
+        children.clear();
+        from.forEachChild([&children](char32_t c, const Src& child) {
+            children.emplace_back(c, &child);
+        });
+        std::sort(children.begin(), children.end(),
+                  [](const auto& a, const auto& b) { return (a.first < b.first); });
+        auto& to = nodes[i];
+        to.fResult = from.result();
+        to.fIsFinal = from.isFinal();
+        to.fDepth = from.depth();
+        to.iFirstChild = nodes.size();
+        to.nChildren = children.size();
+        // to is invalidated here!
+        for (auto& [c, child] : children) {
+            nodes.emplace_back();
+            keys.push_back(c);
+            src.push_back(child);
+        }
+    }
+    nodes.shrink_to_fit();
+    keys.shrink_to_fit();
+    buildRoot();
+}
+
+template <srh::Result R>
+void srh::CompactTrie<R>::buildRoot()
+{
+    // Empty sequence is never decoded
+    nodes[0].fIsFinal = false;
+    for (auto& v : nodes)
+        maxDepth = std::max<unsigned>(maxDepth, v.fDepth);
+    auto& root = nodes[0];
+    for (auto k = root.iFirstChild; k < root.iFirstChild + root.nChildren; ++k) {
+        auto c = keys[k];
+        auto i = c >> 6;
+        if (i >= rootBits.size())
+            rootBits.resize(i + 1);
+        rootBits[i] |= uint64_t(1) << (c & 63);
+    }
+    rootRanks.resize(rootBits.size());
+    uint32_t rank = 0;
+    for (size_t i = 0; i < rootBits.size(); ++i) {
+        rootRanks[i] = rank;
+        rank += std::popcount(rootBits[i]);
+    }
+}
+
+template <srh::Result R>
+uint32_t srh::CompactTrie<R>::childOf(uint32_t iNode, char32_t c) const
+{
+    auto& node = nodes[iNode];
+    auto beg = keys.begin() + node.iFirstChild;
+    auto end = beg + node.nChildren;
+    auto it = std::lower_bound(beg, end, c);
+    if (it == end || *it != c)
+        return NO_NODE;
+    return it - keys.begin();
+}
+
+template <srh::Result R>
+uint32_t srh::CompactTrie<R>::fastChildOf(uint32_t iNode, char32_t c) const
+{
+    if (iNode != 0)
+        return childOf(iNode, c);
+    if (!isRootKey(c))
+        return NO_NODE;
+    auto i = c >> 6;
+    auto below = rootBits[i] & ((uint64_t(1) << (c & 63)) - 1);
+    return nodes[0].iFirstChild + rootRanks[i] + std::popcount(below);
+}
+
+template <srh::Result R>
+auto srh::CompactTrie<R>::findChild(const Node* p, char32_t c) const -> const Node*
+{
+    auto q = childOf(p - nodes.data(), c);
+    return (q != NO_NODE) ? &nodes[q] : nullptr;
+}
+
+template <srh::Result R>
+srh::CompactTrie<R>::Decoder::Decoder(const CompactTrie& aTrie)
+    : trie(&aTrie),
+      mask(std::bit_ceil(aTrie.maxDepth + 2u) - 1),
+      chars(mask + 1) {}
+
+template <srh::Result R>
+void srh::CompactTrie<R>::Decoder::emitLast(SafeVector<Decoded<R>>& r)
+{
+    auto& node = trie->nodes[iLast];
+    r.emplace_back(iLastEnd - node.fDepth, node.fResult);
+    iScan = iLastEnd;
+    iNode = 0;
+    iLast = NO_NODE;
+}
+
+template <srh::Result R>
+void srh::CompactTrie<R>::Decoder::step(char32_t c, SafeVector<Decoded<R>>& r)
+{
+    // Same steps as detail::decode
+    if (auto q = trie->fastChildOf(iNode, c); q != NO_NODE) {
+        iNode = q;
+        ++iScan;
+        if (trie->nodes[q].fIsFinal) {
+            iLast = q;
+            iLastEnd = iScan;
+        }
+    } else if (iNode != 0) {
+        // Dead end: found smth → register and back off
+        if (iLast != NO_NODE) {
+            emitLast(r);
+        } else {
+            // Run through last char again, 1st is never decodeable
+            q = trie->fastChildOf(0, c);
+            iNode = (q != NO_NODE) ? q : 0;
+            ++iScan;
+        }
+    } else {
+        ++iScan;
+    }
+}
+
+template <srh::Result R>
+void srh::CompactTrie<R>::Decoder::feed(char32_t c, SafeVector<Decoded<R>>& r)
+{
+    chars[iPos++ & mask] = c;
+    while (iScan < iPos)
+        step(chars[iScan & mask], r);
+}
+
+template <srh::Result R>
+void srh::CompactTrie<R>::Decoder::finish(SafeVector<Decoded<R>>& r)
+{
+    // Back down even here (incomplete multi-racial kiss, but nothing afterwards)
+    while (iLast != NO_NODE) {
+        emitLast(r);
+        while (iScan < iPos)
+            step(chars[iScan & mask], r);
+    }
+    iNode = 0;
+}
+
+template <srh::Result R>
+SafeVector<srh::Decoded<R>> srh::CompactTrie<R>::decode(std::u32string_view s) const
+{
+    SafeVector<srh::Decoded<R>> r;
+    Decoder decoder(*this);
+    for (auto c : s)
+        decoder.feed(c, r);
+    decoder.finish(r);
+    return r;
+}
+
+template <srh::Result R, class Trie>
+SafeVector<srh::Decoded<R>> srh::detail::decode(const Trie& trie, std::u32string_view s)
+{
+    using Node = std::remove_cvref_t<decltype(*trie.rootNode())>;
+    const Node* const root = trie.rootNode();
     static constexpr size_t NO_RESULT = -1;
     struct Last {
         const Node* node = nullptr;
@@ -132,25 +417,25 @@ SafeVector<srh::Decoded<R>> srh::TrieRoot<R>::decode(std::u32string_view s) cons
     };
 
     for (; ; ++index) {
-        const Node* p = this;
+        const Node* p = root;
         for (; index < s.length(); ++index) {
             char32_t c = s[index];
-            if (auto child = p->find(c)) {
+            if (auto child = trie.findChild(p, c)) {
                 p = child;
                 if (p->isFinal()) {
                     lastKnown.node = p;
                     lastKnown.iLastPos = index;
                 }
-            } else if (p != this) {
+            } else if (p != root) {
                 // p==&trieRoot → we already tried and no need 2nd time
                 // We are at dead end!
                 // Anyway move to root
-                p = this;
+                p = root;
                 // Found smth? (never in root)
                 if (lastKnown.node) {
                     registerResult();
-                // Run through last character again, root’s children are always present
-                } else if (auto child = p->unsafeFind(c)) {
+                // Run through last character again
+                } else if (auto child = trie.findChild(p, c)) {
                     p = child;
                     // 1st is never decodeable
                 }
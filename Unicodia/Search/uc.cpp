@@ -2,7 +2,13 @@
 #include "uc.h"
 
 // STL
-#include <unordered_set>
+#include <bitset>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 // Libs
 #include "u_Strings.h"
@@ -15,7 +21,16 @@
 #include "CharPaint/emoji.h"
 
 // Search
+#include "arena.h"
+#include "fold.h"
+#include "index.h"
+#include "lru.h"
+#include "mnemonic.h"
 #include "nonAscii.h"
+#include "pattern.h"
+#include "request.h"
+#include "session.h"
+#include "shards.h"
 #include "trie.h"
 
 using namespace std::string_view_literals;
@@ -40,6 +55,7 @@ constinit const ec::Array<std::string_view, uc::SearchError> uc::searchErrorKeys
     "Search.NotFound",
     "Search.BadCode",
     "Search.BigCode",
+    "Search.BadPattern",
 };
 
 
@@ -65,18 +81,40 @@ uc::MultiResult::MultiResult(SafeVector<SearchLine>&& aV)
 }
 
 
+uc::MultiResult::MultiResult(std::unique_ptr<LazyLines> aV)
+    : err((!aV || aV->size() == 0) ? SearchError::NOT_FOUND : SearchError::OK)
+{
+    if (err == SearchError::OK) {
+        groups.emplace_back(std::move(aV));
+    }
+}
+
+
 const uc::Cp* uc::MultiResult::one() const
 {
     if (err == SearchError::OK && style == ReplyStyle::FLAT && groups.size() == 1) {
-        auto& lines = groups[0].lines;
-        if (lines.size() == 1 && lines[0].type == CpType::EXISTING) {
-            return lines[0].cp;
+        auto& group = groups[0];
+        if (group.size() == 1) {
+            auto& line = group.lineAt(0);
+            if (line.type == CpType::EXISTING)
+                return line.cp;
         }
     }
     return nullptr;
 }
 
 
+const uc::SearchLine& uc::SearchGroup::lineAt(size_t i) const
+{
+    if (lazy && i >= lines.size()) {
+        // Make a page at once
+        static constexpr size_t PAGE = 256;
+        lazy->makeUpTo((i / PAGE + 1) * PAGE, lines);
+    }
+    return lines[i];
+}
+
+
 bool uc::MultiResult::isEmpty() const
 {
     switch (groups.size()) {
@@ -231,14 +269,15 @@ std::u8string uc::toMnemo(const QString& x)
 
 namespace {
 
-    bool hasEmojiSearch = false;
+    /// Lazy objects are built once, search runs in a separate thread
+    std::once_flag emojiSearchOnce;
 
     /// @todo [future] Can move this set to compile-time?
     std::unordered_map<char32_t, const uc::LibNode*> singleChars;
 
-    using MyNode = srh::TrieNode<const uc::LibNode*>;
     using MyRoot = srh::TrieRoot<const uc::LibNode*>;
-    MyRoot trieRoot;
+    using MyTrie = srh::CompactTrie<const uc::LibNode*>;
+    MyTrie emojiTrie;
 
     struct SearchableName {
         std::u8string_view value;
@@ -269,42 +308,15 @@ namespace {
         });
     }
 
-    SafeVector<std::u8string_view> allHtmlNames(const uc::Cp& cp)
-    {
-        SafeVector<std::u8string_view> r;
-        cp.name.traverseAllT([&r](uc::TextRole role, std::u8string_view text) {
-            switch (role) {
-            case uc::TextRole::HTML:
-                r.push_back(text);
-                break;
-            case uc::TextRole::ALT_NAME:
-            case uc::TextRole::ABBREV:
-            case uc::TextRole::MAIN_NAME:
-            case uc::TextRole::DEP_INSTEAD:
-            case uc::TextRole::DEP_INSTEAD2:
-            case uc::TextRole::CMD_END:
-            case uc::TextRole::EMOJI_NAME:
-                break;
-            }
-        });
-        return r;
-    }
+    /// Set of numerics (indexes in allNumerics)
+    using Numerics = std::bitset<uc::N_NUMERICS>;
 
-    std::unordered_set<unsigned char> findNumerics(
-            long long aNum, long long aDenom)
+    Numerics findNumerics(long long aNum, long long aDenom)
     {
-        std::unordered_set<unsigned char> r;
-        long long altInt = std::numeric_limits<long long>::min();   // never occurs
-        if (aDenom == 1 && aNum != 0) {
-            altInt = aNum;
-        }
-        for (int i = 0; i < uc::N_NUMERICS; ++i) {
-            auto& num = uc::allNumerics[i];
-            if ((num.num == aNum && num.denom == aDenom)
-                    || (num.altInt == altInt)) {
-                r.insert(i);
-            }
-        }
+        Numerics r;
+        // Both values and altInts are there
+        for (auto& key : uc::findNumericKeys(aNum, aDenom))
+            r.set(key.iNumeric);
         return r;
     }
 
@@ -397,30 +409,708 @@ namespace {
 }   // anon namespace
 
 
-void uc::ensureEmojiSearch()
-{
-    if (hasEmojiSearch)
-        return;
-
-    for (auto& node : allLibNodes()) {
-        if (!node.value.empty() && node.flags.have(Lfg::GRAPHIC_EMOJI)) {
-            // Build trie
-            if (node.flags.have(Lfg::DECODEABLE)) {
-                trieRoot.add(node.value, &node);
+namespace {
+
+    constexpr srh::HayId ID_LIBNODE0 = uc::N_CPS;   ///< ID of 0th library node
+
+    srh::HayArena hayArena;
+    srh::WordIndex wordIndex;
+    srh::MnemonicIndex mnemonicIndex;
+    std::once_flag wordIndexOnce;
+
+    void buildWordIndex()
+    {
+        // Arena
+        SafeVector<SearchableName> names;
+        for (size_t i = 0; i < uc::N_CPS; ++i) {
+            allSearchableNamesTo(uc::cpInfo[i], names);
+            for (auto& nm : names)
+                hayArena.add(i, nm.value, nm.comparator);
+        }
+        auto nodes = uc::allLibNodes();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            auto& node = nodes[i];
+            if (node.flags.have(uc::Lfg::SEARCHABLE))
+                hayArena.add(ID_LIBNODE0 + i, node.text, srh::NonAsciiComparator::INST);
+        }
+        hayArena.finish(ID_LIBNODE0 + nodes.size());
+
+        // Index over arena
+        for (srh::HayId id = 0; id < hayArena.nIds(); ++id) {
+            for (auto& nm : hayArena.names(id)) {
+                if (nm.isIndexed())
+                    wordIndex.add(id, hayArena.prepared(nm));
+            }
+        }
+        wordIndex.finish(hayArena.nIds());
+
+        // HTML mnemonics
+        for (srh::HayId id = 0; id < ID_LIBNODE0; ++id) {
+            auto names = hayArena.names(id);
+            for (uint16_t iName = 0; iName < names.size(); ++iName) {
+                if (names[iName].isMnemonic)
+                    mnemonicIndex.add(id, iName, names[iName].value);
             }
-            if (auto q = EmojiPainter::getCp(node.value)) {
-                singleChars[q.cp] = &node;
+        }
+    }
+
+    void ensureWordIndex()
+    {
+        std::call_once(wordIndexOnce, buildWordIndex);
+    }
+
+    struct KeywordContext {
+        const srh::Needle& needle;
+        const Numerics& numerics;
+        const uc::Cp* hex;          ///< found by hex code, do not check
+        const uc::Cp* dec;          ///< found by dec code, do not check
+        std::span<const srh::MnemonicIndex::Hit> mnemonics;  ///< by ID
+        srh::Kernel kernel = srh::bestKernel();
+
+        const srh::MnemonicIndex::Hit* findMnemonic(srh::HayId id) const;
+    };
+
+    const srh::MnemonicIndex::Hit* KeywordContext::findMnemonic(srh::HayId id) const
+    {
+        auto it = std::lower_bound(mnemonics.begin(), mnemonics.end(), id,
+                [](const srh::MnemonicIndex::Hit& x, srh::HayId y) { return (x.id < y); });
+        if (it == mnemonics.end() || it->id != id)
+            return nullptr;
+        return &*it;
+    }
+
+    constexpr uint16_t NO_NAME = std::numeric_limits<uint16_t>::max();
+
+    ///  Compact search result, SearchLine is made of it on demand
+    struct KeywordHit {
+        srh::Prio prio;
+        srh::HayId id;
+        uint16_t iName = NO_NAME;   ///< trigger name in arena, NO_NAME = none
+    };
+
+    void searchCp(srh::HayId id, const KeywordContext& ctx, SafeVector<KeywordHit>& r)
+    {
+        using namespace uc;
+        auto& cp = cpInfo[id];
+        if (&cp == ctx.hex || &cp == ctx.dec)  // Do not check what we found once again
+            return;
+        // Numeric search
+        if (ctx.numerics.test(cp.iNumeric)) {
+            auto& bk = r.emplace_back(srh::Prio{}, id);
+            bk.prio.high = isHiprioNumber(cp)
+                    ? HIPRIO_NUMERIC_HI : HIPRIO_NUMERIC;
+            return;
+        }
+        // Search by HTML mnemonic
+        if (auto mn = ctx.findMnemonic(id)) {
+            auto& bk = r.emplace_back(srh::Prio{}, id, mn->iName);
+            bk.prio.high = mn->isExact
+                    ? HIPRIO_MNEMONIC_EXACT : HIPRIO_MNEMONIC_CASE;
+            return;
+        }
+        // Textual search
+        struct {
+            srh::Prio prio;
+            uint16_t iName = NO_NAME;
+        } best;
+        auto& cat = cp.category();
+        auto block = blockOf(cp.subj);
+        bool isScript =
+                (cp.ecCategory == EcCategory::SYMBOL_MODIFIER   // Some chosen symbol types
+                || cat.upCat == EcUpCategory::LETTER
+                || cat.upCat == EcUpCategory::MARK
+                || block->flags.have(Bfg::SCRIPTLIKE)           // …or char in script-like block
+                || !cp.script().flags.have(Sfg::NONSCRIPT));    // …or char has script (nonscripts are NONE and pseudo-scripts)
+        auto hclass = isScript ? srh::HaystackClass::SCRIPT : srh::HaystackClass::NONSCRIPT;
+        auto names = hayArena.names(id);
+        for (uint16_t iName = 0; iName < names.size(); ++iName) {
+            auto& nm = names[iName];
+            if (nm.isKeyword) {
+                // Search by keyword
+                if (auto pr = srh::findNeedle(ctx.kernel,
+                            hayArena.prepared(nm), hayArena.words(nm),
+                            ctx.needle, hclass);
+                        pr > best.prio) {
+                    best.prio = pr;
+                    best.iName = iName;
+                }
             }
         }
+        if (best.prio > srh::Prio::EMPTY) {
+            if (names[best.iName].value == cp.name.tech())
+                best.iName = NO_NAME;
+            r.emplace_back(best.prio, id, best.iName);
+        }
     }
-    hasEmojiSearch = true;
+
+    void searchLibNode(srh::HayId id, const KeywordContext& ctx, SafeVector<KeywordHit>& r)
+    {
+        for (auto& nm : hayArena.names(id)) {
+            auto prio = srh::findNeedle(ctx.kernel,
+                    hayArena.prepared(nm), hayArena.words(nm),
+                    ctx.needle, srh::HaystackClass::EMOJI);
+            if (prio > srh::Prio::EMPTY) {
+                r.emplace_back(prio, id);
+            }
+        }
+    }
+
+    /// Keyword/mnemonic/numeric search over one haystack
+    void searchHaystack(srh::HayId id, const KeywordContext& ctx, SafeVector<KeywordHit>& r)
+    {
+        if (id < ID_LIBNODE0) {
+            searchCp(id, ctx, r);
+        } else {
+            searchLibNode(id, ctx, r);
+        }
+    }
+
+    /// Less is not worth a thread
+    constexpr size_t MIN_HAYSTACKS_PER_SHARD = 2000;
+
+    /// Keyword/mnemonic/numeric search over all candidates, in parallel
+    /// Results go in ascending ID order, as in sequential search
+    void searchHaystacks(
+            const srh::IdSet& candidates, const KeywordContext& ctx,
+            std::stop_token stopToken, SafeVector<KeywordHit>& r)
+    {
+        SafeVector<srh::HayId> ids;
+        candidates.forEach([&ids](srh::HayId id) { ids.push_back(id); });
+
+        const size_t nShards = srh::nShardsFor(ids.size(), MIN_HAYSTACKS_PER_SHARD);
+        SafeVector<SafeVector<KeywordHit>> shardResults(nShards);
+        srh::runShards(nShards, [&](size_t iShard) {
+            auto beg = ids.size() * iShard / nShards;
+            auto end = ids.size() * (iShard + 1) / nShards;
+            auto& shardR = shardResults[iShard];
+            for (auto i = beg; i < end && !stopToken.stop_requested(); ++i)
+                searchHaystack(ids[i], ctx, shardR);
+        });
+
+        // Merge in shard order
+        for (auto& v : shardResults)
+            r.insert(r.end(), v.begin(), v.end());
+    }
+
+    /// @return [+] some name of haystack matches pattern
+    bool matchesPattern(srh::HayId id, const srh::Pattern& pattern, uint16_t& iName)
+    {
+        auto names = hayArena.names(id);
+        for (iName = 0; iName < names.size(); ++iName) {
+            auto& nm = names[iName];
+            if (nm.isKeyword && !nm.isMnemonic
+                    && pattern.matches(hayArena.prepared(nm)))
+                return true;
+        }
+        return false;
+    }
+
+    /// Wildcard/regex search over all haystacks, in parallel
+    /// Results go in ascending ID order, at most uc::MAX_PATTERN_HITS
+    /// @return [+] results are cut, there are more
+    bool searchPattern(
+            const srh::Pattern& pattern, std::stop_token stopToken,
+            SafeVector<KeywordHit>& r)
+    {
+        const size_t nIds = hayArena.nIds();
+        const size_t nShards = srh::nShardsFor(nIds, MIN_HAYSTACKS_PER_SHARD);
+        SafeVector<SafeVector<KeywordHit>> shardResults(nShards);
+        SafeVector<char> isShardCut(nShards, false);   // not vector<bool>: shards write at once
+        srh::runShards(nShards, [&](size_t iShard) {
+            srh::HayId beg = nIds * iShard / nShards;
+            srh::HayId end = nIds * (iShard + 1) / nShards;
+            auto& shardR = shardResults[iShard];
+            for (auto id = beg; id < end && !stopToken.stop_requested(); ++id) {
+                uint16_t iName;
+                if (matchesPattern(id, pattern, iName)) {
+                    if (shardR.size() >= uc::MAX_PATTERN_HITS) {
+                        isShardCut[iShard] = true;
+                        break;
+                    }
+                    if (id < ID_LIBNODE0
+                            && hayArena.names(id)[iName].value == uc::cpInfo[id].name.tech())
+                        iName = NO_NAME;
+                    shardR.emplace_back(srh::Prio{}, id, iName);
+                }
+            }
+        });
+
+        // Merge in shard order
+        bool isCut = std::find(isShardCut.begin(), isShardCut.end(), true) != isShardCut.end();
+        for (auto& v : shardResults) {
+            auto n = std::min(v.size(), uc::MAX_PATTERN_HITS - r.size());
+            if (n < v.size())
+                isCut = true;
+            r.insert(r.end(), v.begin(), v.begin() + n);
+        }
+        return isCut;
+    }
+
+    ///
+    ///  Keyword search results, by query.
+    ///  Key is normalized needle + whatever else affects search
+    ///  (translation, numerics, codes, mnemonics), value is hits before sorting
+    ///
+    class KeywordCache
+    {
+    public:
+        using Hits = std::shared_ptr<const SafeVector<KeywordHit>>;
+        static std::u8string makeKey(const KeywordContext& ctx, unsigned locSerial);
+        /// @return [+] found  [0] not found
+        Hits find(const std::u8string& key);
+        void put(const std::u8string& key, Hits hits);
+        uc::SearchCacheStats stats();
+        void clear();
+    private:
+        static constexpr size_t MAX_QUERIES = 64;
+        static constexpr size_t MAX_HITS = 500'000;   ///< ≈10M memory
+        std::mutex mut;
+        srh::LruCache<std::u8string, Hits> cache { MAX_QUERIES, MAX_HITS };
+        unsigned generation = 0;
+
+        void checkGeneration();
+    } keywordCache;
+
+    std::u8string KeywordCache::makeKey(const KeywordContext& ctx, unsigned locSerial)
+    {
+        std::u8string r;
+        auto appendNum = [&r](uint32_t x) {
+            r.append(reinterpret_cast<const char8_t*>(&x), sizeof(x));
+        };
+        // Raw words: fuzzy ones depend on them only
+        for (auto& w : ctx.needle.words) {
+            r += w.v;
+            r += ' ';
+        }
+        r += '\n';
+        appendNum(ctx.hex ? ctx.hex->subj.ch32() : 0);
+        appendNum(ctx.dec ? ctx.dec->subj.ch32() : 0);
+        for (int i = 0; i < uc::N_NUMERICS; ++i) {
+            if (ctx.numerics.test(i))
+                appendNum(i);
+        }
+        r += '\n';
+        for (auto& v : ctx.mnemonics) {
+            appendNum(v.id);
+            appendNum((v.iName << 1) | v.isExact);
+        }
+        appendNum(locSerial);
+        return r;
+    }
+
+    void KeywordCache::checkGeneration()
+    {
+        auto newGeneration = uc::translationGeneration();
+        if (newGeneration != generation) {
+            cache.clear();
+            generation = newGeneration;
+        }
+    }
+
+    auto KeywordCache::find(const std::u8string& key) -> Hits
+    {
+        std::lock_guard lk(mut);
+        checkGeneration();
+        if (auto p = cache.find(key))
+            return *p;
+        return {};
+    }
+
+    void KeywordCache::put(const std::u8string& key, Hits hits)
+    {
+        std::lock_guard lk(mut);
+        checkGeneration();
+        auto weight = hits->size();
+        cache.put(key, std::move(hits), weight);
+    }
+
+    void KeywordCache::clear()
+    {
+        std::lock_guard lk(mut);
+        cache.clear();
+    }
+
+    uc::SearchCacheStats KeywordCache::stats()
+    {
+        std::lock_guard lk(mut);
+        return { .nHits = cache.nHits(), .nMisses = cache.nMisses(), .size = cache.size() };
+    }
+
+    ///// Localized names /////////////////////////////////////////////////////
+
+    ///
+    ///  Localized names of blocks and scripts, folded and split once
+    ///  per language. They are few, so matched once per search,
+    ///  then matches go to chars.
+    ///
+    struct LocIndex {
+        static constexpr srh::HayId ID_SCRIPT0 = uc::N_BLOCKS;
+        std::deque<std::u8string> texts;    ///< own copies, arena keeps views
+        srh::HayArena arena;
+        unsigned serial = 0;
+    };
+
+    std::mutex locIndexMutex;
+    std::shared_ptr<const LocIndex> locIndex;
+    unsigned locIndexSerial = 0;
+
+    std::shared_ptr<const LocIndex> currentLocIndex()
+    {
+        std::lock_guard lk(locIndexMutex);
+        return locIndex;
+    }
+
+    /// @return [+] x can be a localized name: letters of any script etc.
+    bool isLocNameChar(QStringView x)
+    {
+        if (x.length() < 2)
+            return false;
+        for (auto v : x) {
+            if (!v.isLetter() && !uc::isNameChar(v.unicode()))
+                return false;
+        }
+        return true;
+    }
+
+    /// Merges hits, better wins
+    /// @param [in,out] hits   in ascending ID order, and remain so
+    /// @param [in] more       in ascending ID order too
+    void mergeHits(SafeVector<KeywordHit>& hits, const SafeVector<KeywordHit>& more)
+    {
+        if (more.empty())
+            return;
+        SafeVector<KeywordHit> merged;
+        merged.reserve(hits.size() + more.size());
+        auto p = hits.begin();
+        for (auto& v : more) {
+            while (p != hits.end() && p->id < v.id)
+                merged.push_back(*(p++));
+            if (p != hits.end() && p->id == v.id) {
+                merged.push_back((v.prio > p->prio) ? v : *p);
+                ++p;
+            } else {
+                merged.push_back(v);
+            }
+        }
+        merged.insert(merged.end(), p, hits.end());
+        hits = std::move(merged);
+    }
+
+    /// Chars [beg, end) of cpInfo found with some prio
+    struct PrioRun {
+        srh::HayId beg, end;
+        srh::Prio prio;
+    };
+
+    /// @param [in] runs  do not overlap
+    /// @return  hits in ascending ID order
+    SafeVector<KeywordHit> runsToHits(SafeVector<PrioRun>& runs)
+    {
+        std::sort(runs.begin(), runs.end(),
+                  [](const PrioRun& x, const PrioRun& y) { return x.beg < y.beg; });
+        SafeVector<KeywordHit> r;
+        for (auto& run : runs) {
+            for (auto id = run.beg; id < run.end; ++id)
+                r.emplace_back(run.prio, id);
+        }
+        return r;
+    }
+
+    /// Adds chars whose localized block/script names match
+    /// @param [in,out] hits   in ascending ID order, and remain so
+    void searchLoc(const LocIndex& index, std::u8string_view what,
+                   const KeywordContext& ctx, SafeVector<KeywordHit>& hits)
+    {
+        srh::Needle needle(srh::fold(what));
+        auto& arena = index.arena;
+        SafeVector<srh::Prio> prios(arena.nIds());
+        bool hasAny = false;
+        for (srh::HayId id = 0; id < arena.nIds(); ++id) {
+            for (auto& nm : arena.names(id)) {
+                if (auto pr = srh::findNeedle(ctx.kernel,
+                            arena.prepared(nm), arena.words(nm),
+                            needle, srh::HaystackClass::SCRIPT, srh::classifyFolded);
+                        pr > prios[id]) {
+                    prios[id] = pr;
+                    hasAny = true;
+                }
+            }
+        }
+        if (!hasAny)
+            return;
+
+        // Go to chars run by run, only found ones
+        // Blocks are contiguous in cpInfo
+        SafeVector<PrioRun> blockRuns;
+        auto blocks = uc::allBlocks();
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            auto& blk = blocks[i];
+            if (prios[i] > srh::Prio::EMPTY && blk.firstAllocated)
+                blockRuns.push_back({ .beg = srh::HayId(blk.firstAllocated - uc::cpInfo),
+                                      .end = srh::HayId(blk.lastAllocated + 1 - uc::cpInfo),
+                                      .prio = prios[i] });
+        }
+        // Scripts are in property index
+        SafeVector<PrioRun> scriptRuns;
+        for (int i = 0; i < uc::N_SCRIPTS; ++i) {
+            auto& prio = prios[LocIndex::ID_SCRIPT0 + i];
+            if (prio > srh::Prio::EMPTY) {
+                for (auto& run : uc::charsOfScript(static_cast<uc::EcScript>(i)).runs())
+                    scriptRuns.push_back({ .beg = run.beg, .end = run.end, .prio = prio });
+            }
+        }
+
+        // Both: char in found block and found script → better wins
+        auto locHits = runsToHits(blockRuns);
+        mergeHits(locHits, runsToHits(scriptRuns));
+        mergeHits(hits, locHits);
+    }
+
+    ///// Debrief //////////////////////////////////////////////////////////////
+
+    const MyTrie& readyEmojiTrie()
+    {
+        uc::ensureEmojiSearch();
+        return emojiTrie;
+    }
+
+    ///
+    ///  Splits string into chars and emoji. Pasted text can be hundreds of KB,
+    ///  so it is made into lines by chunks as the view scrolls,
+    ///  and stats are counted along.
+    ///
+    class DebriefLines final : public uc::LazyLines
+    {
+    public:
+        explicit DebriefLines(std::u32string&& aText);
+        size_t size() const override { return nMoved + made.size() - nPending; }
+        void makeUpTo(size_t n, SafeVector<uc::SearchLine>& lines) override;
+        bool canFetchMore() const override { return (iChar < text.length()); }
+        size_t prefetch() override;
+        void acceptFetched() override { nPending = 0; }
+        size_t estimatedSize() const override;
+        const uc::DebriefStats* debriefStats() const override { return &stats; }
+    private:
+        static constexpr size_t CHUNK = 1000;  ///< code points
+        const std::u32string text;
+        MyTrie::Decoder decoder { readyEmojiTrie() };
+        SafeVector<uc::DecodedEmoji> emoji;     ///< decoded, not made into lines yet
+        size_t iEmoji = 0;
+        size_t iChar = 0;       ///< 1st char not made into lines
+        size_t iLevel1 = 0;     ///< chars before are inside emoji
+        std::deque<uc::SearchLine> made;        ///< made, not moved to group yet
+        size_t nMoved = 0, nPending = 0;
+        uc::DebriefStats stats;
+
+        void makeChunk();
+        void count(const uc::SearchLine& line);
+    };
+
+    DebriefLines::DebriefLines(std::u32string&& aText)
+        : text(std::move(aText))
+    {
+        stats.nTotalChars = text.length();
+        // 1st chunk at once: result is known to be non-empty, one() works
+        while (size() == 0 && canFetchMore()) {
+            prefetch();
+            acceptFetched();
+        }
+    }
+
+    void DebriefLines::count(const uc::SearchLine& line)
+    {
+        ++stats.types[line.type];
+        if (line.cp) {
+            ++stats.scripts[static_cast<size_t>(line.cp->ecScript)];
+            ++stats.categories[static_cast<size_t>(line.cp->ecCategory)];
+        }
+        if (auto block = uc::blockOf(line.code))
+            ++stats.blocks[block->permanentIndex()];
+    }
+
+    void DebriefLines::makeChunk()
+    {
+        auto end = std::min(iChar + CHUNK, text.length());
+        // Emoji starting before end are known
+        while (decoder.nKnown() < end) {
+            if (decoder.nFed() < text.length()) {
+                decoder.feed(text[decoder.nFed()], emoji);
+            } else {
+                decoder.finish(emoji);
+            }
+        }
+
+        for (; iChar < end; ++iChar) {
+            // Insert emoji
+            if (iEmoji < emoji.size() && emoji[iEmoji].index == iChar) {
+                auto& bk = made.emplace_back(emoji[iEmoji].result);
+                bk.prio.high = uc::HIPRIO_HEX;
+                iLevel1 = iChar + bk.node->value.length();
+                ++iEmoji;
+                ++stats.nEmoji;
+            }
+            auto find = uc::findCode(text[iChar]);
+            if (find.err == uc::SearchError::OK) {
+                auto& bk = made.emplace_back(find);
+                bk.prio.high = uc::HIPRIO_HEX;
+                bk.nestLevel = static_cast<int>(iChar < iLevel1);
+                count(bk);
+            }
+        }
+        stats.nChars = iChar;
+
+        // Emoji already made into lines
+        emoji.erase(emoji.begin(), emoji.begin() + iEmoji);
+        iEmoji = 0;
+    }
+
+    size_t DebriefLines::prefetch()
+    {
+        if (nPending == 0 && canFetchMore()) {
+            auto oldSize = made.size();
+            makeChunk();
+            nPending = made.size() - oldSize;
+        }
+        return nPending;
+    }
+
+    void DebriefLines::makeUpTo(size_t n, SafeVector<uc::SearchLine>& lines)
+    {
+        n = std::min(n, size());
+        while (lines.size() < n) {
+            lines.push_back(std::move(made.front()));
+            made.pop_front();
+            ++nMoved;
+        }
+    }
+
+    size_t DebriefLines::estimatedSize() const
+    {
+        // Lines per char are as in what we made
+        auto nMade = nMoved + made.size();
+        if (iChar == 0)
+            return nMade;
+        return nMade + nMade * (text.length() - iChar) / iChar;
+    }
+
+    uc::MultiResult debrief(const QString& what)
+    {
+        return uc::MultiResult(std::make_unique<DebriefLines>(what.toStdU32String()));
+    }
+
+    ///// Patterns /////////////////////////////////////////////////////////////
+
+    /// @return [+] what is regex (in slashes) or wildcard:
+    ///   name chars with * ?, otherwise “?!” would be a wildcard, not a debrief
+    std::optional<srh::PatternSyntax> detectPattern(const QString& what)
+    {
+        if (what.size() >= 2 && what.startsWith('/') && what.endsWith('/'))
+            return srh::PatternSyntax::REGEX;
+        if (what.contains('*') || what.contains('?')) {
+            auto naked = what;
+            naked.remove('*').remove('?');
+            if (!naked.isEmpty() && uc::isNameChar(naked))
+                return srh::PatternSyntax::WILDCARD;
+        }
+        return std::nullopt;
+    }
+
+    ///
+    ///  Keyword search results: few eager lines (hex, flag…) + compact hits.
+    ///  Order is the same as stable_sort of eager lines, then hits
+    ///  in ID order. Hits are sorted page by page, as they are viewed.
+    ///
+    class KeywordLines final : public uc::LazyLines
+    {
+    public:
+        KeywordLines(SafeVector<uc::SearchLine>&& aEager, SafeVector<KeywordHit>&& aHits);
+        size_t size() const override { return eager.size() + hits.size(); }
+        void makeUpTo(size_t n, SafeVector<uc::SearchLine>& lines) override;
+    private:
+        SafeVector<uc::SearchLine> eager;
+        SafeVector<KeywordHit> hits;
+        size_t iEager = 0, iHit = 0, nSortedHits = 0;
+
+        void sortMoreHits();
+        static uc::SearchLine makeLine(const KeywordHit& hit);
+    };
+
+    KeywordLines::KeywordLines(
+            SafeVector<uc::SearchLine>&& aEager, SafeVector<KeywordHit>&& aHits)
+        : eager(std::move(aEager)), hits(std::move(aHits))
+    {
+        std::stable_sort(eager.begin(), eager.end());
+    }
+
+    void KeywordLines::sortMoreHits()
+    {
+        static constexpr size_t PAGE = 256;
+        auto newN = std::min(hits.size(), nSortedHits + PAGE);
+        // IDs are unique → equal to stable sort by prio, descending
+        std::partial_sort(hits.begin() + nSortedHits, hits.begin() + newN, hits.end(),
+            [](const KeywordHit& x, const KeywordHit& y) {
+                auto q = (x.prio <=> y.prio);
+                if (q != 0)
+                    return (q > 0);
+                return (x.id < y.id);
+            });
+        nSortedHits = newN;
+    }
+
+    uc::SearchLine KeywordLines::makeLine(const KeywordHit& hit)
+    {
+        if (hit.id >= ID_LIBNODE0)
+            return { &uc::allLibNodes()[hit.id - ID_LIBNODE0], hit.prio };
+        std::u8string_view triggerName;
+        if (hit.iName != NO_NAME)
+            triggerName = hayArena.names(hit.id)[hit.iName].value;
+        return { uc::cpInfo[hit.id], triggerName, hit.prio };
+    }
+
+    void KeywordLines::makeUpTo(size_t n, SafeVector<uc::SearchLine>& lines)
+    {
+        n = std::min(n, size());
+        while (lines.size() < n) {
+            if (iHit >= nSortedHits && nSortedHits < hits.size())
+                sortMoreHits();
+            // Eager lines were earlier → they win when equal
+            bool isEager = (iEager < eager.size())
+                    && (iHit >= hits.size() || !(hits[iHit].prio > eager[iEager].prio));
+            if (isEager) {
+                lines.push_back(std::move(eager[iEager++]));
+            } else {
+                lines.push_back(makeLine(hits[iHit++]));
+            }
+        }
+    }
+
+}   // anon namespace
+
+
+void uc::ensureEmojiSearch()
+{
+    std::call_once(emojiSearchOnce, [] {
+        MyRoot trieRoot;
+        for (auto& node : allLibNodes()) {
+            if (!node.value.empty() && node.flags.have(Lfg::GRAPHIC_EMOJI)) {
+                // Build trie
+                if (node.flags.have(Lfg::DECODEABLE)) {
+                    trieRoot.add(node.value, &node);
+                }
+                if (auto q = EmojiPainter::getCp(node.value)) {
+                    singleChars[q.cp] = &node;
+                }
+            }
+        }
+        emojiTrie = MyTrie(trieRoot);
+    });
 }
 
 
 SafeVector<uc::DecodedEmoji> uc::decodeEmoji(std::u32string_view s)
 {
     ensureEmojiSearch();
-    return trieRoot.decode(s);
+    return emojiTrie.decode(s);
 }
 
 namespace {
@@ -449,7 +1139,8 @@ namespace {
 }
 
 
-uc::MultiResult uc::doSearch(QString what)
+uc::MultiResult uc::doSearch(
+        QString what, srh::Session* session, std::stop_token stopToken)
 {
     if (what.isEmpty())
         return { SearchError::NO_SEARCH };
@@ -480,33 +1171,48 @@ uc::MultiResult uc::doSearch(QString what)
         return codeResult;
     }
 
+    if (auto syntax = detectPattern(what)) {
+        // SEARCH BY WILDCARD/REGEX
+        auto source = (*syntax == srh::PatternSyntax::REGEX)
+                ? what.mid(1, what.size() - 2) : what;
+        auto u8Source = source.toStdString();
+        srh::Pattern pattern;
+        if (pattern.compile(toU8(u8Source), *syntax) != srh::PatternStatus::OK)
+            return { SearchError::BAD_PATTERN };
+        ensureWordIndex();
+        SafeVector<KeywordHit> hits;
+        bool isTruncated = searchPattern(pattern, stopToken, hits);
+        if (stopToken.stop_requested())
+            return { SearchError::NO_SEARCH };
+        // All are equal → ID order
+        uc::MultiResult r(std::make_unique<KeywordLines>(
+                    SafeVector<uc::SearchLine>{}, std::move(hits)));
+        r.isTruncated = isTruncated;
+        return r;
+    }
+
     SafeVector<uc::SearchLine> r;
 
     if (auto mnemo = toMnemo(what); !mnemo.empty()) {
         // SEARCH BY HTML MNEMONIC
-        // Search
-        for (auto& cp : uc::cpInfo) {
-            auto names = allHtmlNames(cp);
-            for (auto& nm : names) {
-                if (mnemo == nm) {
-                    auto& v = r.emplace_back(cp);
-                    v.prio.high = uc::HIPRIO_MNEMONIC_EXACT;
-                    v.triggerName = nm;
-                    break;
-                } if (srh::stringsCiEq(mnemo, nm)) {
-                    auto& v = r.emplace_back(cp);
-                    v.prio.high = uc::HIPRIO_MNEMONIC_CASE;
-                    v.triggerName = nm;
-                    break;
-                }
-            }
+        ensureWordIndex();
+        SafeVector<srh::MnemonicIndex::Hit> hits;
+        mnemonicIndex.find(mnemo, hits);
+        for (auto& hit : hits) {
+            auto& v = r.emplace_back(uc::cpInfo[hit.id]);
+            v.prio.high = hit.isExact
+                    ? uc::HIPRIO_MNEMONIC_EXACT : uc::HIPRIO_MNEMONIC_CASE;
+            v.triggerName = hayArena.names(hit.id)[hit.iName].value;
         }
 
         // Sort by relevance
         std::stable_sort(r.begin(), r.end());
 
         return r;
-    } else if (isNameChar(what)) {
+    } else if (auto loc = currentLocIndex();
+               isNameChar(what) || (loc && isLocNameChar(what))) {
+        // Localized words only: found nothing → debrief them
+        const bool isLocOnly = !isNameChar(what);
         const bool isLongEnoughNumber = (what.size() >= 2);
 
         // Try find hex
@@ -534,9 +1240,9 @@ uc::MultiResult uc::doSearch(QString what)
             ensureEmojiSearch();
             static constexpr auto OFS_FLAGA = cp::FLAG_A - 'A';
             const auto cp1 = char32_t(flagName[0]) + OFS_FLAGA;
-            if (auto where1 = trieRoot.unsafeFind(cp1)) {
+            if (auto where1 = emojiTrie.findChild(emojiTrie.rootNode(), cp1)) {
                 const auto cp2 = char32_t(flagName[1]) + OFS_FLAGA;
-                auto where2 = where1->find(cp2);
+                auto where2 = emojiTrie.findChild(where1, cp2);
                 if (where2 && where2->result()) {
                     // At last found
                     auto& bk = r.emplace_back(where2->result());
@@ -547,7 +1253,7 @@ uc::MultiResult uc::doSearch(QString what)
         }
 
         // Find number
-        std::unordered_set<unsigned char> numerics;
+        Numerics numerics;
         if (code != NO_CODE) {
             // Integer
             numerics = findNumerics(code, 1);
@@ -594,109 +1300,96 @@ uc::MultiResult uc::doSearch(QString what)
 
         // SEARCH BY KEYWORD/mnemonic
         auto u8Name = what.toStdString();
-        auto sv = toU8(u8Name);
-        srh::Needle needle(sv);
-        srh::Cache cache;
-        SafeVector<SearchableName> names;
-        for (auto& cp : uc::cpInfo) {
-            if (&cp != hex && &cp != dec) {  // Do not check what we found once again
-                // Numeric search
-                if (numerics.contains(cp.iNumeric)) {
-                    auto& bk = r.emplace_back(cp);
-                    bk.prio.high = isHiprioNumber(cp)
-                            ? HIPRIO_NUMERIC_HI : HIPRIO_NUMERIC;
-                } else {
-                    // Textual search
-                    allSearchableNamesTo(cp, names);
-                    struct {
-                        srh::Prio prio;
-                        std::u8string_view name;
-                    } best;
-                    auto& cat = cp.category();
-                    auto block = blockOf(cp.subj);
-                    bool isScript =
-                            (cp.ecCategory == EcCategory::SYMBOL_MODIFIER   // Some chosen symbol types
-                            || cat.upCat == EcUpCategory::LETTER
-                            || cat.upCat == EcUpCategory::MARK
-                            || block->flags.have(Bfg::SCRIPTLIKE)           // …or char in script-like block
-                            || !cp.script().flags.have(Sfg::NONSCRIPT));    // …or char has script (nonscripts are NONE and pseudo-scripts)
-                    auto hclass = isScript ? srh::HaystackClass::SCRIPT : srh::HaystackClass::NONSCRIPT;
-                    for (auto& nm : names) {
-                        if (nm.value.starts_with('&')) {
-                            // Search by HTML mnemonic
-                            if (nm.value.size() == sv.size() + 2) {
-                                auto mnemo = nm.value.substr(1, sv.size());
-                                if (sv == mnemo) {
-                                    auto& bk = r.emplace_back(cp, nm.value);
-                                    bk.prio.high = HIPRIO_MNEMONIC_EXACT;
-                                    goto brk;
-                                } else if (srh::stringsCiEq(sv, mnemo)) {
-                                    auto& bk = r.emplace_back(cp, nm.value);
-                                    bk.prio.high = HIPRIO_MNEMONIC_CASE;
-                                    goto brk;
-                                }
-                            }
-                        } if (nm.value.find('#') == std::u8string_view::npos) {
-                            // Search by keyword
-                            if (auto pr = srh::findNeedle(
-                                        nm.value, needle, hclass, cache, nm.comparator);
-                                    pr > best.prio) {
-                                best.prio = pr;
-                                best.name = nm.value;
-                            }
-                        }
-                    }
-                    if (best.prio > srh::Prio::EMPTY) {
-                        if (best.name == names[0].value)
-                            best.name = u8""sv;
-                        r.emplace_back(cp, best.name, best.prio);
-                    }
-                }
-            brk:;
-            }
+        srh::Needle needle(toU8(u8Name));
+        ensureWordIndex();
+        SafeVector<srh::MnemonicIndex::Hit> mnemonics;
+        mnemonicIndex.find(u8"&" + std::u8string{toU8(u8Name)} + u8";", mnemonics);
+        KeywordContext ctx {
+            .needle = needle, .numerics = numerics,
+            .hex = hex, .dec = dec, .mnemonics = mnemonics };
+
+        // Already searched?
+        auto cacheKey = KeywordCache::makeKey(ctx, loc ? loc->serial : 0);
+        if (auto cached = keywordCache.find(cacheKey)) {
+            auto hits = *cached;
+            return uc::MultiResult(std::make_unique<KeywordLines>(std::move(r), std::move(hits)));
         }
 
-        // Same search, but emoji
-        for (auto& node: uc::allLibNodes()) {
-            if (!node.flags.have(uc::Lfg::SEARCHABLE))
-                continue;
-            auto prio = srh::findNeedle(
-                    node.text, needle, srh::HaystackClass::EMOJI, cache,
-                    srh::NonAsciiComparator::INST);
-            if (prio > srh::Prio::EMPTY) {
-                r.emplace_back(&node, prio);
+        // Fuzzy words are slow, and made of needle only → not in cache key
+        wordIndex.addFuzzyWords(needle);
+
+        // Narrow down: index + numerics + mnemonics
+        srh::IdSet candidates;
+        if (session) {
+            session->findCandidates(hayArena, wordIndex, needle, candidates);
+        } else {
+            candidates.reset(wordIndex.nIds());
+            wordIndex.findCandidates(needle, candidates);
+        }
+        for (int i = 0; i < uc::N_NUMERICS; ++i) {
+            if (numerics.test(i)) {
+                for (auto iCp : uc::cpsOfNumeric(i))
+                    candidates.add(iCp);
             }
         }
-
-        // Sort by relevance
-        std::stable_sort(r.begin(), r.end());
+        for (auto& v : mnemonics)
+            candidates.add(v.id);
+
+        // Search over candidates, same order as in cpInfo, then libNodes
+        SafeVector<KeywordHit> hits;
+        searchHaystacks(candidates, ctx, stopToken, hits);
+        if (loc)
+            searchLoc(*loc, toU8(u8Name), ctx, hits);
+        if (stopToken.stop_requested())
+            return { SearchError::NO_SEARCH };
+        if (isLocOnly && hits.empty() && r.empty())
+            return debrief(what);
+        keywordCache.put(cacheKey, std::make_shared<SafeVector<KeywordHit>>(hits));
+
+        // Sort by relevance, lazily
+        return uc::MultiResult(std::make_unique<KeywordLines>(std::move(r), std::move(hits)));
     } else {
         // DEBRIEF STRING
-        auto u32 = what.toStdU32String();
+        return debrief(what);
+    }
+}
 
-        auto emojiList = decodeEmoji(u32);
-        auto pEmoji = emojiList.begin();
-        size_t iLevel1 = 0;
 
-        for (size_t i32 = 0; i32 < u32.length(); ++i32) {
-            // Insert emoji
-            if (pEmoji != emojiList.end() && pEmoji->index == i32) {
-                auto& bk = r.emplace_back(pEmoji->result);
-                bk.prio.high = HIPRIO_HEX;
-                iLevel1 = i32 + bk.node->value.length();
-                ++pEmoji;
-            }
-            auto c = u32[i32];
-            auto find = uc::findCode(c);
-            if (find.err == SearchError::OK) {
-                auto& bk = r.emplace_back(find);
-                bk.prio.high = HIPRIO_HEX;
-                bk.nestLevel = static_cast<int>(i32 < iLevel1);
-            }
+void uc::buildLocSearch(bool isNeeded)
+{
+    std::shared_ptr<LocIndex> r;
+    if (isNeeded) {
+        r = std::make_shared<LocIndex>();
+        auto add = [&r](srh::HayId id, std::u8string_view text) {
+            if (!text.empty())
+                r->arena.add(id, r->texts.emplace_back(text), srh::FoldComparator::INST);
+        };
+        auto blocks = allBlocks();
+        for (size_t i = 0; i < blocks.size(); ++i)
+            add(i, blocks[i].loc.name);
+        for (int i = 0; i < N_SCRIPTS; ++i) {
+            auto& sc = scriptInfo[i];
+            if (!sc.flags.have(Sfg::NONSCRIPT))
+                add(LocIndex::ID_SCRIPT0 + i, sc.loc.name);
         }
+        r->arena.finish(LocIndex::ID_SCRIPT0 + N_SCRIPTS);
     }
+    std::lock_guard lk(locIndexMutex);
+    if (r)
+        r->serial = ++locIndexSerial;
+    locIndex = std::move(r);
+}
+
+
+uc::SearchCacheStats uc::searchCacheStats()
+{
+    return keywordCache.stats();
+}
 
-    return r;
+
+void uc::clearSearchCache()
+{
+    keywordCache.clear();
 }
 
 
@@ -1,5 +1,9 @@
 #pragma once
 
+// STL
+#include <array>
+#include <stop_token>
+
 // Qt
 #include <QString>
 
@@ -12,6 +16,10 @@
 // Unicode
 #include "UcAutoDefines.h"
 
+namespace srh {
+    class Session;
+}
+
 namespace uc {
 
     struct Cp;
@@ -31,7 +39,8 @@ namespace uc {
         NO_SEARCH,          ///< Search did not occur at all
         NOT_FOUND,
         CONVERT_ERROR,
-        TOO_BIG)
+        TOO_BIG,
+        BAD_PATTERN)        ///< wildcard/regex is bad or too complex
     extern const ec::Array<std::string_view, SearchError> searchErrorKeys;
 
     enum {
@@ -117,15 +126,63 @@ namespace uc {
             { return static_cast<SearchGroupObjType>(index()); }
     };
 
+    ///
+    ///  What is in debriefed (pasted) text, counted as it is fetched
+    ///
+    struct DebriefStats {
+        size_t nChars = 0;          ///< code points fetched
+        size_t nTotalChars = 0;     ///< code points in text
+        size_t nEmoji = 0;
+        ec::Array<size_t, CpType> types {};
+        std::array<size_t, N_SCRIPTS> scripts {};
+        std::array<size_t, static_cast<size_t>(EcCategory::NN)> categories {};
+        std::array<size_t, N_BLOCKS> blocks {};     ///< by index in uc::blocks
+
+        bool isComplete() const { return (nChars == nTotalChars); }
+    };
+
+    ///
+    ///  Lines that are made on demand: wide search (say “a”) gives
+    ///  tens of thousands of them, and few are really viewed
+    ///
+    class LazyLines
+    {
+    public:
+        /// # of lines, for streaming ones # of lines fetched
+        virtual size_t size() const = 0;
+        /// Appends lines [lines.size(), n) to lines
+        virtual void makeUpTo(size_t n, SafeVector<SearchLine>& lines) = 0;
+
+        // Streaming lines: size() grows as the view scrolls (Qt’s fetchMore)
+        virtual bool canFetchMore() const { return false; }
+        /// Makes next chunk; it does not count in size() until acceptFetched()
+        /// @return  # of lines in chunk
+        virtual size_t prefetch() { return 0; }
+        virtual void acceptFetched() {}
+        /// @return  # of lines when everything is fetched, maybe estimated
+        virtual size_t estimatedSize() const { return size(); }
+        /// @return [+] stats of debriefed text, fetched part
+        virtual const DebriefStats* debriefStats() const { return nullptr; }
+
+        virtual ~LazyLines() = default;
+    };
+
     struct SearchGroup {
         SearchGroupObj obj;
-        SafeVector<SearchLine> lines;
+        /// All lines, or lines already made if lazy
+        /// @warning  Lazy group grows lines when reading → do not keep references
+        mutable SafeVector<SearchLine> lines;
+        std::unique_ptr<LazyLines> lazy {};
 
         SearchGroup() = default;
         explicit SearchGroup(SafeVector<SearchLine>&& x) : lines(std::move(x)) {}
+        explicit SearchGroup(std::unique_ptr<LazyLines> x) : lazy(std::move(x)) {}
 
-        size_t size() const { return lines.size(); }
-        bool isEmpty() const { return lines.empty(); }
+        size_t size() const { return lazy ? lazy->size() : lines.size(); }
+        bool isEmpty() const { return (size() == 0); }
+        bool canFetchMore() const { return lazy && lazy->canFetchMore(); }
+        /// @pre  i < size()
+        const SearchLine& lineAt(size_t i) const;
     };
 
     enum class ReplyStyle : unsigned char {
@@ -145,11 +202,13 @@ namespace uc {
         uc::EcVersion version = uc::EcVersion::NO_VALUE;
         PrimaryObj primaryObj = PrimaryObj::DFLT;
         SafeVector<SearchGroup> groups {};
+        bool isTruncated = false;       ///< [+] cut by MAX_PATTERN_HITS, there are more
 
         MultiResult(ReplyStyle x, EcVersion v, PrimaryObj obj)
             : style(x), version(v), primaryObj(obj) {}
         MultiResult(const SingleResult& x);
         MultiResult(SafeVector<SearchLine>&& aV);
+        MultiResult(std::unique_ptr<LazyLines> aV);
         const uc::Cp* one() const;
         bool isEmpty() const;
         bool hasSmth() const { return !isEmpty(); }
@@ -157,10 +216,30 @@ namespace uc {
 
     using DecodedEmoji = srh::Decoded<const uc::LibNode*>;
 
+    /// Pattern goes over all names, and /./ gives everything → limit it
+    constexpr size_t MAX_PATTERN_HITS = 5000;
+
     constexpr long long NO_CODE = -1;
     SingleResult findCode(unsigned long long ull);
     SingleResult findStrCode(QStringView what, int base, long long& code);
-    MultiResult doSearch(QString what);
+    /// Thread-safe, but one session should not be used by two threads at once
+    /// @param [in,out] session  [0] search from scratch
+    ///                          [+] refine previous results if possible
+    /// @param [in] stopToken    search is cancelled → NO_SEARCH
+    MultiResult doSearch(QString what, srh::Session* session = nullptr,
+                         std::stop_token stopToken = {});
+
+    /// Builds index of localized names, call after translation
+    /// @param [in] isNeeded  [-] English UI, names are searched as usual
+    void buildLocSearch(bool isNeeded);
+
+    struct SearchCacheStats {
+        size_t nHits = 0, nMisses = 0, size = 0;
+    };
+    /// Keyword searches are cached; translation invalidates cache
+    SearchCacheStats searchCacheStats();
+    /// Forgets cached searches, for benchmarks
+    void clearSearchCache();
     bool isNameChar(char32_t cp);
     bool isNameChar(QStringView x);
     bool isMnemoChar(char32_t cp);
@@ -171,6 +250,5 @@ namespace uc {
 
     /// Finds emoji (including VS16)
     /// @return  node containing x (maybe x+VS16)
-    /// @warning  Lazy and unprotected → do not run in thread
     const uc::LibNode* findEmoji(char32_t x);
 }
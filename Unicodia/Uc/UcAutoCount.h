@@ -6,6 +6,9 @@ namespace uc {
 constexpr int N_CPS = 155063;
 constexpr int N_BLOCKS = 332;
 constexpr int N_NUMERICS = 216;
+constexpr int N_NUMERIC_CPS = 2066;
+constexpr int N_NUMERIC_KEYS = 217;
 constexpr unsigned LONGEST_LIB = 10;  // in codepoints
 constexpr unsigned N_OLDCOMP_SPANS = 36;
+constexpr unsigned long long PACK_STAMP = 0x775bcec85c99d8c8ull;  // see UcPack.h
 }
@@ -21,6 +21,7 @@
 namespace uc {
 
     constexpr int N_PLANES = 17;
+    constexpr int CAPACITY = 65536 * N_PLANES;
 
     enum class EcScript : unsigned char {
         Zyyy,
@@ -340,6 +341,7 @@ namespace uc {
             std::u8string_view traverseAll(const TextSink& sink) const;
             template <class Body> inline std::u8string_view traverseAllT(const Body& body) const;
 
+            /// Constant time, via record header (see nameHeaderSize)
             /// @return  [+] the 1st text if that role
             ///          [0] no text of that role
             std::u8string_view getText(TextRole role) const;
@@ -412,9 +414,80 @@ namespace uc {
     static_assert(sizeof(Cp) == 16, "Cp size wrong");
 
     extern Cp cpInfo[N_CPS];
+    /// Code point → char, two-level: page # by code / CP_PAGE, then
+    ///   index in cpInfo + 1 (0 = none). Empty pages are all page 0.
+    ///   Use cpsByCode rather than these
+    constexpr int CP_PAGE = 256;
+    extern const unsigned short cpPageIndex[CAPACITY / CP_PAGE];
+    extern const unsigned cpPages[][CP_PAGE];
+    /// Code / 16 → index in blocks, −1 = none
+    extern const short blocksByCode16[CAPACITY >> 4];
+
+    ///
+    ///  Hot columns: cpXxx[i] == cpInfo[i].ecXxx, one byte per char,
+    ///  so that full scans over a field or two are cache-friendly
+    ///  and vectorize; see scanColumn.
+    ///  No flags here: they are 2 bytes, and some change at runtime
+    ///
+    constexpr size_t COLUMN_ALIGN = 64;
+    alignas(COLUMN_ALIGN) extern const EcScript cpScripts[N_CPS];
+    alignas(COLUMN_ALIGN) extern const EcVersion cpVersions[N_CPS];
+    alignas(COLUMN_ALIGN) extern const EcCategory cpCategories[N_CPS];
+    alignas(COLUMN_ALIGN) extern const EcBidiClass cpBidiClasses[N_CPS];
+
+    ///
+    ///  Stats of chars made by AutoBuilder: completeData puts them
+    ///  to blocks, scripts etc. rather than counting on every launch
+    ///
+    struct BlockStats {
+        unsigned iFirst, iLast;         ///< indexes in cpInfo
+        unsigned nChars;
+        EcVersion ecVersion, ecLastVersion;
+    };
+    struct ScriptStats {
+        EcScript ecScript;
+        unsigned nChars;
+        int plane;                      ///< of 1st char
+        EcVersion ecVersion;            ///< Coptic is 4.1 (those chars were Greek)
+    };
+    struct CategoryStats {
+        EcCategory ecCategory;
+        unsigned nChars;
+    };
+    struct BidiClassStats {
+        EcBidiClass ecBidiClass;
+        unsigned nChars;
+    };
+    ///  New chars of version
+    struct VersionStats {
+        EcVersion ecVersion;
+        unsigned nHani, nNewScripts, nExistingScripts, nFormat, nSymbols;
+    };
+    extern const BlockStats blockStats[N_BLOCKS];
+    /// Only those that have chars
+    extern const std::span<const ScriptStats> scriptStats;
+    extern const std::span<const CategoryStats> categoryStats;
+    extern const std::span<const BidiClassStats> bidiClassStats;
+    extern const std::span<const VersionStats> versionStats;
     extern const char8_t allStrings[];
     extern const Numeric allNumerics[N_NUMERICS];
 
+    ///  Value → numeric; altInt goes as num = altInt, denom = 1
+    struct NumericKey {
+        long long num, denom;
+        unsigned char iNumeric;
+    };
+    /// Sorted by (num, denom), NaN is absent
+    extern const NumericKey numericKeys[N_NUMERIC_KEYS];
+    /// Chars of numeric #i are numericCps[numericCpStarts[i]…numericCpStarts[i+1]),
+    ///   indexes in cpInfo; NaN has none
+    extern const unsigned numericCpStarts[N_NUMERICS + 1];
+    extern const unsigned numericCps[N_NUMERIC_CPS];
+    /// @return indexes of chars having numeric #iNumeric
+    std::span<const unsigned> cpsOfNumeric(int iNumeric);
+    /// @return numerics having value num/denom
+    std::span<const NumericKey> findNumericKeys(long long num, long long denom);
+
     enum class TitleMode : unsigned char { SHORT, LONG };
 
     struct LibNode {
@@ -1,5 +1,6 @@
 // Automatically generated, do not edit!
 #include "UcFlags.h"
+#ifndef UC_PACK_ONLY
 constinit const sw::Char sw::data[sw::CLEN] = {
 {.rot=65535,.fill=63,.minSpecialFill=9},  // 1d800
 {.rot=65535,.fill=63,.minSpecialFill=9},  // 1d801
@@ -654,3 +655,4 @@ constinit const sw::Char sw::data[sw::CLEN] = {
 {.rot=255,.fill=1,.minSpecialFill=9},  // 1da8a
 {.rot=255,.fill=1,.minSpecialFill=9},  // 1da8b
 };
+#endif
@@ -1,6 +1,11 @@
 #include "UcData.h"
 
+// STL
+#include <array>
+#include <atomic>
+
 // Qt
+#include <QFile>
 #include <QFontDatabase>
 #include <QFontMetrics>
 #include <QRawFont>
@@ -14,6 +19,7 @@
 
 // Unicode
 #include "UcCp.h"
+#include "UcPack.h"
 #include "UcSkin.h"
 
 // L10n
@@ -27,8 +33,6 @@ using ReverseMap = Cmap<char16_t, unsigned char, 128>;
 template class Cmap<char16_t, unsigned char, 128>;
 
 using namespace std::string_view_literals;
-const uc::Cp* uc::cpsByCode[CAPACITY];
-short uc::blocksByCode16[CAPACITY >> 4];
 const QString uc::Font::qempty;
 const uc::GlyphStyleSets uc::GlyphStyleSets::EMPTY;
 constinit const uc::InputMethods uc::InputMethods::NONE {};
@@ -983,6 +987,62 @@ Flags<uc::OldComp> uc::cpOldComps(char32_t cp)
 }
 
 
+///// Data pack ////////////////////////////////////////////////////////////////
+
+namespace {
+
+    // Embedded tables, or data pack’s ones
+#ifdef UC_PACK_ONLY
+    const char8_t* stringBase = nullptr;
+    const sw::Char* suttonBase = nullptr;
+#else
+    const char8_t* stringBase = uc::allStrings;
+    const sw::Char* suttonBase = sw::data;
+#endif
+
+}   // anon namespace
+
+
+bool uc::mapDataPack(const QString& fname)
+{
+    static QFile file;
+    if (file.isOpen())
+        return false;
+    file.setFileName(fname);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    auto size = file.size();
+    auto data = file.map(0, size);
+    pack::View view;
+    bool isOk = data && view.open({ data, static_cast<size_t>(size) }, PACK_STAMP);
+#ifdef UC_VERIFY_DATA
+    isOk = isOk && view.verify();
+#endif
+    pack::Bytes strings, sutton;
+    if (isOk) {
+        strings = view.section(pack::SecId::STRINGS);
+        sutton = view.section(pack::SecId::SUTTON);
+        if (sutton.size() != sizeof(sw::Char[sw::CLEN]))
+            sutton = {};
+#ifdef UC_PACK_ONLY
+        // Nothing to fall back to
+        isOk = !strings.empty() && !sutton.empty();
+#endif
+    }
+    if (!isOk) {
+        if (data)
+            file.unmap(data);
+        file.close();
+        return false;
+    }
+    if (!strings.empty())
+        stringBase = reinterpret_cast<const char8_t*>(strings.data());
+    if (!sutton.empty())
+        suttonBase = reinterpret_cast<const sw::Char*>(sutton.data());
+    return true;
+}
+
+
 ///// Sutton SignWriting ///////////////////////////////////////////////////////
 
 sw::Info::Info(const uc::Cp& aCp) : fCp(aCp), fData(&EMPTY_CHAR)
@@ -990,7 +1050,7 @@ sw::Info::Info(const uc::Cp& aCp) : fCp(aCp), fData(&EMPTY_CHAR)
     auto index = fCp.subj.ch32() - 0x1D800;
     if (index < sw::CLEN) {
         // OK, we are here!
-        fData = &sw::data[index];
+        fData = &suttonBase[index];
     }
 }
 
@@ -1147,77 +1207,155 @@ namespace {
             completeEmojiData(i);
     }
 
+#ifdef UC_VERIFY_DATA
+
+    void checkStats(bool isOk, const char* what)
+    {
+        if (!isOk)
+            throw std::logic_error(std::string{"AutoBuilder made bad stats: "} + what);
+    }
+
+    ///  Counts stats of chars the old way and checks what AutoBuilder made
+    void verifyCharStats()
+    {
+        using namespace uc;
+
+        for (int iBlock = 0; iBlock < N_BLOCKS; ++iBlock) {
+            auto& block = blocks[iBlock];
+            for (auto i16 = block.startingCp >> 4; i16 <= (block.endingCp >> 4); ++i16)
+                checkStats(blocksByCode16[i16] == iBlock, "blocksByCode16");
+        }
+
+        struct BlockQ {
+            const Cp* first = nullptr;
+            const Cp* last = nullptr;
+            int nChars = 0;
+            EcVersion ecVersion = EcVersion::NN, ecLastVersion = EcVersion::FIRST;
+        };
+        struct ScriptQ {
+            unsigned nChars = 0;
+            int plane = PLANE_UNKNOWN;
+            EcVersion ecVersion = EcVersion::TOO_HIGH;
+        };
+        std::array<BlockQ, N_BLOCKS> blockQ;
+        std::array<ScriptQ, N_SCRIPTS> scriptQ;
+        std::array<unsigned, static_cast<int>(EcCategory::NN)> categoryQ {};
+        std::array<unsigned, static_cast<int>(EcBidiClass::NN)> bidiClassQ {};
+        histogramColumn(cpCategories, categoryQ);
+        histogramColumn(cpBidiClasses, bidiClassQ);
+        for (auto& cp : cpInfo) {
+            auto& script = scriptQ[static_cast<int>(cp.ecScript)];
+            ++script.nChars;
+            script.ecVersion = std::min(script.ecVersion, cp.ecVersion);
+            if (script.plane == PLANE_UNKNOWN)
+                script.plane = cp.plane();
+            auto& block = blockQ[blockOf(cp.subj.val())->permanentIndex()];
+            if (!block.first)
+                block.first = &cp;
+            block.last = &cp;
+            ++block.nChars;
+            block.ecVersion = std::min(block.ecVersion, cp.ecVersion);
+            block.ecLastVersion = std::max(block.ecLastVersion, cp.ecVersion);
+        }
+        // Coptic is 4.1 (script of those characters was Greek)
+        scriptQ[static_cast<int>(EcScript::Copt)].ecVersion = EcVersion::V_4_1;
+
+        for (int i = 0; i < N_BLOCKS; ++i) {
+            auto& q = blockQ[i];
+            auto& block = blocks[i];
+            checkStats(q.first == block.firstAllocated && q.last == block.lastAllocated
+                       && q.nChars == block.nChars && q.ecVersion == block.ecVersion
+                       && q.ecLastVersion == block.ecLastVersion, "block");
+        }
+        for (unsigned i = 0; i < N_SCRIPTS; ++i) {
+            auto& q = scriptQ[i];
+            auto& script = scriptInfo[i];
+            checkStats(q.nChars == script.nChars && q.plane == script.plane
+                       && q.ecVersion == script.ecVersion, "script");
+        }
+        for (size_t i = 0; i < categoryQ.size(); ++i)
+            checkStats(categoryQ[i] == categoryInfo[i].nChars, "category");
+        for (size_t i = 0; i < bidiClassQ.size(); ++i)
+            checkStats(bidiClassQ[i] == bidiClassInfo[i].nChars, "bidi class");
+        for (size_t i = 0; i < N_CPS; ++i) {
+            auto& cp = cpInfo[i];
+            checkStats(cpScripts[i] == cp.ecScript && cpVersions[i] == cp.ecVersion
+                       && cpCategories[i] == cp.ecCategory
+                       && cpBidiClasses[i] == cp.ecBidiClass, "hot column");
+        }
+
+        // Versions
+        std::array<uc::Version::Stats::Chars::Nw, static_cast<int>(EcVersion::NN)> versionQ {};
+        for (auto& cp : cpInfo) {
+            auto& nw = versionQ[static_cast<int>(cp.ecVersion)];
+            switch (cp.ecScript) {
+            case EcScript::Hani:
+                ++nw.nHani; break;
+            case EcScript::NONE:
+            case EcScript::Zinh:
+                if (cp.ecCategory == EcCategory::FORMAT) {
+                    ++nw.nFormat; break;
+                } else {
+                    ++nw.nSymbols; break;
+                }
+            default:
+                if (scriptQ[static_cast<int>(cp.ecScript)].ecVersion == cp.ecVersion) {
+                    ++nw.nNewScripts;
+                } else {
+                    ++nw.nExistingScripts;
+                }
+            }
+        }
+        for (size_t i = 0; i < versionQ.size(); ++i) {
+            auto& q = versionQ[i];
+            auto& nw = versionInfo[i].stats.chars.nw;
+            checkStats(q.nHani == nw.nHani && q.nNewScripts == nw.nNewScripts
+                       && q.nExistingScripts == nw.nExistingScripts
+                       && q.nFormat == nw.nFormat && q.nSymbols == nw.nSymbols, "version");
+        }
+    }
+
+#endif
+
 }   // anon namespace
 
 
 void uc::completeData()
 {
-    // Fill CP → block mapping
-    std::fill(std::begin(blocksByCode16), std::end(blocksByCode16), -1);
+    // Stats of chars are made by AutoBuilder
     for (int iBlock = 0; iBlock < N_BLOCKS; ++iBlock) {
         auto& block = blocks[iBlock];
-        auto i16 = block.startingCp >> 4;
-        auto end16 = block.endingCp >> 4;
-        for (; i16 <= end16; ++i16)
-            blocksByCode16[i16] = iBlock;
-    }
-
-    // Fill CP info
-    std::fill(std::begin(cpsByCode), std::end(cpsByCode), nullptr);
-    for (auto& cp : cpInfo) {
-        // Bidi class
-        ++cp.bidiClass().nChars;
-        // Category
-        ++cp.category().nChars;
-        // Script
-        auto& script = cp.script();
-        ++script.nChars;
-        script.ecVersion = std::min(script.ecVersion, cp.ecVersion);
-        if (script.plane == PLANE_UNKNOWN)
-            script.plane = cp.plane();
-        // Block
-        char32_t code = cp.subj;
-        auto block = blockOf(code);
-        if (!block->firstAllocated)
-            block->firstAllocated = &cp;
-        block->lastAllocated = &cp;
-        ++block->nChars;
-        block->ecVersion = std::min(block->ecVersion, cp.ecVersion);
-        block->ecLastVersion = std::max(block->ecLastVersion, cp.ecVersion);
-        // Lookup table
-        cpsByCode[cp.subj.val()] = &cp;
-    }
-
-    // Coptic is 4.1 (script of those characters was Greek)
-    uc::scriptInfo[static_cast<int>(EcScript::Copt)].ecVersion = uc::EcVersion::V_4_1;
-
-    for (auto& cp : cpInfo) {
-        // Version
-        auto& ver = cp.version();
-        switch (cp.ecScript) {
-        case EcScript::Hani:
-            ++ver.stats.chars.nw.nHani; break;
-        case EcScript::NONE:
-        case EcScript::Zinh:
-            if (cp.ecCategory == EcCategory::FORMAT) {
-                ++ver.stats.chars.nw.nFormat; break;
-            } else {
-                ++ver.stats.chars.nw.nSymbols; break;
-            }
-        default:
-            if (cp.script().ecVersion == cp.ecVersion) {
-                ++ver.stats.chars.nw.nNewScripts;
-            } else {
-                ++ver.stats.chars.nw.nExistingScripts;
-            }
-        }
-    }
-
-    // Check blocks — they should have at least one char
+        auto& stats = blockStats[iBlock];
+        block.firstAllocated = &cpInfo[stats.iFirst];
+        block.lastAllocated = &cpInfo[stats.iLast];
+        block.nChars = stats.nChars;
+        block.ecVersion = stats.ecVersion;
+        block.ecLastVersion = stats.ecLastVersion;
+    }
+    for (auto& v : scriptStats) {
+        auto& script = scriptInfo[static_cast<int>(v.ecScript)];
+        script.nChars = v.nChars;
+        script.plane = v.plane;
+        script.ecVersion = v.ecVersion;
+    }
+    for (auto& v : categoryStats)
+        categoryInfo[static_cast<int>(v.ecCategory)].nChars = v.nChars;
+    for (auto& v : bidiClassStats)
+        bidiClassInfo[static_cast<int>(v.ecBidiClass)].nChars = v.nChars;
+    for (auto& v : versionStats) {
+        auto& nw = versionInfo[static_cast<int>(v.ecVersion)].stats.chars.nw;
+        nw.nHani = v.nHani;
+        nw.nNewScripts = v.nNewScripts;
+        nw.nExistingScripts = v.nExistingScripts;
+        nw.nFormat = v.nFormat;
+        nw.nSymbols = v.nSymbols;
+    }
+#ifdef UC_VERIFY_DATA
+    verifyCharStats();
+#endif
+
+    // Check blocks (AutoBuilder checks that they have chars)
     for (auto& v : allBlocks()) {
-        if (!v.firstAllocated || !v.lastAllocated)
-            throw std::logic_error("Block w/o chars leaked into data!");
-
         // Check synthesized icon        
         if (!v.synthIcon.flags.have(Ifg::MISSING)) {
             auto sv = v.synthIcon.subj.sv();
@@ -1510,6 +1648,17 @@ const QString& uc::Font::familiesComma() const
 }
 
 
+const CompressedBits* uc::Font::cachedCoverage() const
+{
+    if (!q.isCoverageKnown) {
+        q.isCoverageKnown = true;
+        if (isFontFname(family.text))
+            q.coverage = findFontCoverage(expandTempFontName(family.text));
+    }
+    return q.coverage;
+}
+
+
 bool uc::Font::doesSupportChar(char32_t subj) const
 {
     // Font rejected → we support nothing
@@ -1522,6 +1671,12 @@ bool uc::Font::doesSupportChar(char32_t subj) const
         if (a != subj)
             return true;
     }
+    // Not loaded yet → maybe we know coverage from cache;
+    // empty coverage = check by probeMetrics, so load
+    if (!q.loaded) {
+        if (auto cov = cachedCoverage(); cov && cov->hasSmth())
+            return cov->have(subj);
+    }
     // Then load and check using one of methods:
     // rawFont or probeMetrics
     load(subj);
@@ -1557,7 +1712,8 @@ int uc::Font::computeSize(FontPlace place, int size) const
 
 std::u8string_view uc::Cp::Name::traverseAll(const TextSink& sink) const
 {
-    auto p = allStrings + iTech.val();
+    auto p = stringBase + iTech.val();
+    p += nameHeaderSize(*p);
     while (true) {
         auto role = static_cast<TextRole>(*(p++));
         switch (role) {
@@ -1593,16 +1749,24 @@ brk:
 
 std::u8string_view uc::Cp::Name::getText(TextRole role) const
 {
-    return traverseAllT([role](TextRole aRole, std::u8string_view) {
-        return static_cast<Action>(role == aRole);
-    });
+    auto p = stringBase + iTech.val();
+    unsigned mask = *p;
+    if (!(mask & textRoleBit(role)))
+        return {};
+    if (role == TextRole::MAIN_NAME) {
+        p += nameHeaderSize(mask);
+    } else {
+        auto q = p + 1 + 2 * nameOffsetSlot(mask, role);
+        p += (q[0] | (q[1] << 8));
+    }
+    // p → role, length, chars
+    return { p + 2, static_cast<unsigned char>(p[1]) };
 }
 
 
 const std::u8string_view uc::Cp::Name::tech() const
 {
-    return traverseAllT([](TextRole role, std::u8string_view)
-                          { return stopIf(role == TextRole::MAIN_NAME); } );
+    return getText(TextRole::MAIN_NAME);
 }
 
 
@@ -1622,8 +1786,7 @@ std::u8string_view uc::Cp::abbrev() const
 {
     if (!isAbbreviated())
         return {};
-    return name.traverseAllT([](TextRole role, std::u8string_view)
-                               { return stopIf(role == TextRole::ABBREV); } );
+    return name.getText(TextRole::ABBREV);
 }
 
 
@@ -2016,6 +2179,84 @@ void uc::Term::printfLocKeyN(char* buf, size_t n, const char* suffix) const
     snprintf(buf, n, "Term.%s.%s", key.data(), suffix);
 }
 
+
+///// Lazy L10n ////////////////////////////////////////////////////////////////
+
+
+namespace {
+
+    template <class T>
+    std::u8string_view getLoc(const T& obj, const char* suffix)
+    {
+        char c[40];
+        obj.printfLocKey(c, suffix);
+        return loc::get(c);
+    }
+
+}   // anon namespace
+
+
+std::u8string_view uc::Script::locTimeComment() const
+{
+    return loc.timeComment.get([this]() -> std::u8string_view {
+        return time.needsCustomNote() ? getLoc(*this, "Note") : std::u8string_view{};
+    });
+}
+
+
+std::u8string_view uc::Script::locLangs() const
+{
+    return loc.langs.get([this]() -> std::u8string_view {
+        return flags.have(Sfg::NO_LANGS) ? std::u8string_view{} : getLoc(*this, "Lang");
+    });
+}
+
+
+std::u8string_view uc::Script::locDescription() const
+{
+    return loc.description.get([this]() -> std::u8string_view {
+        if (flags.have(Sfg::DESC_FROM_PREV))
+            return (this - 1)->locDescription();
+        return getLoc(*this, "Text");
+    });
+}
+
+
+std::u8string_view uc::Block::locDescription() const
+{
+    return loc.description.get([this]() -> std::u8string_view {
+        return hasDescription() ? getLoc(*this, "Text") : std::u8string_view{};
+    });
+}
+
+
+std::u8string_view uc::Category::locDescription() const
+{
+    return loc.description.get([this] { return getLoc(*this, "Text"); });
+}
+
+
+std::u8string_view uc::BidiClass::locShortName() const
+{
+    return loc.shortName.get([this] { return getLoc(*this, "Short"); });
+}
+
+
+std::u8string_view uc::BidiClass::locDescription() const
+{
+    return loc.description.get([this] { return getLoc(*this, "Text"); });
+}
+
+
+std::u8string_view uc::Term::locDescription() const
+{
+    return loc.description.get([this]() -> std::u8string_view {
+        if (borrowedDesc.empty())
+            return getLoc(*this, "Text");
+        return loc::get(borrowedDesc);
+    });
+}
+
 const uc::Term* uc::findTerm(std::string_view id)
 {
     for (auto& v : terms) {
@@ -2114,6 +2355,12 @@ namespace {
 }   // anon namespace
 
 
+namespace {
+    /// Atomic: searches read it from worker thread
+    std::atomic<unsigned> nTranslations = 0;
+}
+
+
 void uc::finishTranslation(
         const std::unordered_map<char32_t, int>& sortOrder,
         std::u32string_view ellipsisBlocks,
@@ -2121,28 +2368,13 @@ void uc::finishTranslation(
 {
     char c[40];
 
+    // Names only: descriptions and the like are lazy, see LocMemo
     for (unsigned i = 0; i < uc::N_SCRIPTS; ++i) {
         auto& sc = uc::scriptInfo[i];
         if (!sc.flags.have(Sfg::SORT_KEY)) {
             sc.printfLocKey(c, "Name");
             sc.loc.name = loc::get(c);
         }
-        if (!sc.flags.have(Sfg::NO_LANGS)) {
-            sc.printfLocKey(c, "Lang");
-            sc.loc.langs = loc::get(c);
-        }
-        if (sc.time.needsCustomNote()) {
-            sc.printfLocKey(c, "Note");
-            sc.loc.timeComment = loc::get(c);
-        }
-        if (sc.flags.have(Sfg::DESC_FROM_PREV)) {
-            auto p = &sc;
-            --p;
-            sc.loc.description = p->loc.description;
-        } else {
-            sc.printfLocKey(c, "Text");
-            sc.loc.description = loc::get(c);
-        }
     }
 
     // Blocks, pass 1 (retrieve keys)
@@ -2151,11 +2383,6 @@ void uc::finishTranslation(
         blk.loc.name = loc::get(c);
         blk.loc.hasEllipsis = std::binary_search(
                     ellipsisBlocks.begin(), ellipsisBlocks.end(), blk.startingCp);
-
-        if (blk.hasDescription()) {
-            blk.printfLocKey(c, "Text");
-            blk.loc.description = loc::get(c);
-        }
     }
 
     // Blocks, pass 2 (build sort order)
@@ -2179,17 +2406,11 @@ void uc::finishTranslation(
     for (auto& bidi : bidiClassInfo) {
         bidi.printfLocKey(c, "Name");
             bidi.loc.name = loc::get(c);
-        bidi.printfLocKey(c, "Short");
-            bidi.loc.shortName = loc::get(c);
-        bidi.printfLocKey(c, "Text");
-            bidi.loc.description = loc::get(c);
     }
 
     for (auto& cat : categoryInfo) {
         cat.printfLocKey(c, "Name");
             cat.loc.name = loc::get(c);
-        cat.printfLocKey(c, "Text");
-            cat.loc.description = loc::get(c);
     }
 
     auto pSorted = std::begin(sortedTerms);
@@ -2201,14 +2422,6 @@ void uc::finishTranslation(
         // Build sort key
         buildSortKey(term.loc.name, SpecialSort::YES, sortOrder, term.loc.sortKey);
 
-        // Get desc
-        if (term.borrowedDesc.empty()) {
-            term.printfLocKey(c, "Text");
-            term.loc.description = loc::get(c);
-        } else {
-            term.loc.description = loc::get(term.borrowedDesc);
-        }
-
         // Add to sorted
         *(pSorted++) = &term;
     }
@@ -2224,9 +2437,14 @@ void uc::finishTranslation(
         }
     }
     sortTerms(pBeg, std::end(sortedTerms));
+
+    ++nTranslations;
 }
 
 
+unsigned uc::translationGeneration() { return nTranslations; }
+
+
 uc::FracType uc::Numeric::fracType() const
 {
     if (!isPresent())
@@ -2241,6 +2459,27 @@ uc::FracType uc::Numeric::fracType() const
 }
 
 
+std::span<const unsigned> uc::cpsOfNumeric(int iNumeric)
+{
+    if (iNumeric < 0 || iNumeric >= N_NUMERICS)
+        return {};
+    auto beg = numericCpStarts[iNumeric];
+    auto end = numericCpStarts[iNumeric + 1];
+    return std::span{ numericCps }.subspan(beg, end - beg);
+}
+
+
+std::span<const uc::NumericKey> uc::findNumericKeys(long long num, long long denom)
+{
+    auto [beg, end] = std::equal_range(
+            std::begin(numericKeys), std::end(numericKeys), NumericKey{ num, denom, 0 },
+            [](const NumericKey& x, const NumericKey& y) {
+                return (x.num != y.num) ? (x.num < y.num) : (x.denom < y.denom);
+            });
+    return { beg, end };
+}
+
+
 size_t uc::appendUPLUS(char* buf, size_t n, size_t n1, char32_t code)
 {
     if (n1 == 0)
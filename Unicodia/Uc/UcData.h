@@ -1,6 +1,9 @@
 #pragma once
 
 // STL
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <string>
 
 // Qt
@@ -22,6 +25,7 @@
 #include "UcContinents.h"
 
 class QIcon;
+class CompressedBits;
 
 constexpr char32_t NO_TRIGGER = 0xDEADBEEF;
 
@@ -89,6 +93,31 @@ namespace uc {
     constexpr QChar STUB_PUA_CJK_APPROX { 0xE010 };         // Image of CJK 303E
     constexpr QChar STUB_PUA_PLUS { 0xE011 };               // Plus for synthesized virtual virama
 
+    /// Increased by every finishTranslation, caches of localized stuff check it
+    unsigned translationGeneration();
+
+    ///
+    ///  Localized text got the 1st time it’s needed, and kept till
+    ///  language changes: long descriptions are not got on every switch
+    ///
+    class LocMemo
+    {
+    public:
+        /// @param [in] body  () → localized text
+        template <class Body>
+        std::u8string_view get(const Body& body) const
+        {
+            if (auto gen = translationGeneration(); gen != generation) {
+                value = body();
+                generation = gen;
+            }
+            return value;
+        }
+    private:
+        mutable std::u8string_view value {};
+        mutable unsigned generation = 0;
+    };
+
     enum class EcLangLife : unsigned char {
         NOMATTER,       ///< Symbols (language’s life does not matter)
         ALIVE,          ///< UNESCO safe (Ukrainian)
@@ -548,10 +577,15 @@ namespace uc {
             /// (Brahmi only)
             /// Dubbed as “fall to next” for description font
             bool isRejected = false;
+            /// Coverage from on-disk cache, valid until font is loaded
+            const CompressedBits* coverage = nullptr;
+            bool isCoverageKnown = false;
             consteval Q() = default;
             consteval Q(const Q&) {};
         } q {};
         void load(char32_t trigger) const;
+        /// @return  coverage of font file w/o installing it, null if unknown
+        const CompressedBits* cachedCoverage() const;
 
         int computeSize(FontPlace place, int size) const;
         QFont get(FontPlace place, int size, Flags<FontGetFg> flags, const uc::Cp* subj) const;
@@ -806,7 +840,8 @@ namespace uc {
         mutable EcVersion ecVersion = EcVersion::TOO_HIGH;
         mutable const Block* mainBlock = nullptr;
         struct Loc {
-            std::u8string_view name, timeComment, langs, description;
+            std::u8string_view name;
+            LocMemo timeComment, langs, description;
         } mutable loc {};
 
         inline const ScriptType& type() const { return scriptTypeInfo[static_cast<int>(ecType)]; }
@@ -814,6 +849,9 @@ namespace uc {
         inline const WritingDir& dir() const { return writingDirInfo[ecDir]; }
         inline const Font& font() const { return fontInfo[static_cast<int>(ecFont)]; }
         const Version& version() const { return versionInfo[static_cast<int>(ecVersion)]; }
+        std::u8string_view locTimeComment() const;
+        std::u8string_view locLangs() const;
+        std::u8string_view locDescription() const;
         void printfLocKey(char* buf, size_t n, const char* suffix) const
             { printfLocKeyN(buf, n, suffix); }
 
@@ -970,12 +1008,13 @@ namespace uc {
 
         mutable struct Loc {
             std::u8string_view name {};
-            std::u8string_view description {};
+            LocMemo description {};
             LocSortKey sortKey {};
             bool hasEllipsis = false;
         } loc {};
 
         size_t permanentIndex() const;
+        std::u8string_view locDescription() const;
         const Version& version() const { return versionInfo[static_cast<int>(ecVersion)]; }
         const Version& lastVersion() const { return versionInfo[static_cast<int>(ecLastVersion)]; }
         const Script& script() const { return scriptInfo[static_cast<int>(ecScript)]; }
@@ -1030,9 +1069,10 @@ namespace uc {
 
         struct Loc {
             std::u8string_view name;
-            std::u8string_view description;
+            LocMemo description;
         } mutable loc {};
 
+        std::u8string_view locDescription() const;
         void printfLocKey(char* buf, size_t n, const char* suffix) const
             { printfLocKeyN(buf, n, suffix); }
 
@@ -1061,10 +1101,12 @@ namespace uc {
         mutable unsigned nChars = 0;
         struct Loc {
             std::u8string_view name;
-            std::u8string_view shortName;
-            std::u8string_view description;
+            LocMemo shortName;
+            LocMemo description;
         } mutable loc {};
 
+        std::u8string_view locShortName() const;
+        std::u8string_view locDescription() const;
         void printfLocKey(char* buf, size_t n, const char* suffix) const
             { printfLocKeyN(buf, n, suffix); }
 
@@ -1080,13 +1122,61 @@ namespace uc {
     extern const Block blocks[];
     inline Buf1d<const Block> allBlocks() noexcept { return { N_BLOCKS, blocks }; }
 
-    constexpr int CAPACITY = 65536 * N_PLANES;
-    extern const Cp* cpsByCode[CAPACITY];
-    extern short blocksByCode16[CAPACITY >> 4];
+    ///  cpsByCode[code] → char or null, O(1)
+    ///  @pre  code < CAPACITY
+    struct CpsByCode {
+        const Cp* operator [](char32_t code) const noexcept
+        {
+            auto iCp = cpPages[cpPageIndex[code / CP_PAGE]][code % CP_PAGE];
+            return iCp ? &cpInfo[iCp - 1] : nullptr;
+        }
+    };
+    inline constexpr CpsByCode cpsByCode {};
+
+    ///  Scans hot column (cpScripts etc.):
+    ///    body(i) for every index i in cpInfo where pred(column[i]), ascending.
+    ///  Predicate goes over chunks of 64 w/o branches, and vectorizes
+    ///  @param [in] pred   cheap, e.g. x == value
+    template <class T, class Pred, class Body>
+    void scanColumn(const T (&column)[N_CPS], const Pred& pred, const Body& body)
+    {
+        constexpr size_t CHUNK = 64;
+        for (size_t i0 = 0; i0 < N_CPS; i0 += CHUNK) {
+            auto n = std::min<size_t>(CHUNK, N_CPS - i0);
+            uint64_t mask = 0;
+            for (size_t j = 0; j < n; ++j)
+                mask |= uint64_t(pred(column[i0 + j])) << j;
+            for (; mask != 0; mask &= mask - 1)
+                body(i0 + std::countr_zero(mask));
+        }
+    }
+
+    ///  @return # of chars where pred(column[i])
+    template <class T, class Pred>
+    size_t countColumn(const T (&column)[N_CPS], const Pred& pred)
+    {
+        size_t r = 0;
+        for (auto v : column)
+            r += pred(v);
+        return r;
+    }
+
+    ///  ++r[value] for every char
+    template <class T, size_t N>
+    void histogramColumn(const T (&column)[N_CPS], std::array<unsigned, N>& r)
+    {
+        for (auto v : column)
+            ++r[static_cast<size_t>(v)];
+    }
 
     // We’ll use this WS for Hani, we could take Japanese as well
     static constexpr auto WS_HANI = QFontDatabase::SimplifiedChinese;
 
+    /// Maps data pack (see UcPack.h) instead of some embedded tables;
+    ///   on any trouble embedded ones stay.
+    ///   UC_PACK_ONLY: no embedded tables, so pack is required
+    /// @return [+] pack is used
+    bool mapDataPack(const QString& fname);
     void completeData();
     const Block* blockOf(char32_t subj);
     inline const uc::Block& uc::Cp::block() const { return *blockOf(subj); }
@@ -1125,11 +1215,12 @@ namespace uc {
         TermSearch search {};
         struct Loc {
             std::u8string_view name;
-            std::u8string_view description;
+            LocMemo description;
             LocSortKey sortKey;
         } mutable loc {};
 
         const TermCat& cat() const { return termCats[static_cast<int>(ecCat)]; }
+        std::u8string_view locDescription() const;
 
         const uc::Font& font() const { return fontInfo[static_cast<int>(ecFont)]; }
 
@@ -8,6 +8,7 @@
 #include "u_TypedFlags.h"
 
 // C++
+#include <bit>
 #include <cassert>
 #include <cstdint>
 
@@ -89,6 +90,27 @@ namespace uc {
         DEP_INSTEAD2 = 6, // For deprecated chars: alternative instead
         EMOJI_NAME = 7, // Emoji name from Library, if inequal
     };
+    constexpr unsigned N_TEXT_ROLES = static_cast<unsigned>(TextRole::EMOJI_NAME) + 1;
+
+    ///
+    ///  Char’s record in allStrings, iTech points here:
+    ///   • role mask, bit per TextRole present — 1 byte
+    ///   • offset from record start of the 1st text of each role except
+    ///     MAIN_NAME, by ascending role — 2 bytes LE each
+    ///   • texts: role, length, chars; MAIN_NAME goes first
+    ///   • CMD_END
+    ///  So any role is got at once, w/o traversing texts
+    ///
+    constexpr unsigned textRoleBit(TextRole role)
+        { return 1u << static_cast<unsigned>(role); }
+    constexpr unsigned nameHeaderSize(unsigned roleMask)
+        { return 1 + 2 * std::popcount(roleMask & ~textRoleBit(TextRole::MAIN_NAME)); }
+    /// @return  # of offset slot of that role, valid if role ≠ MAIN_NAME and it’s in mask
+    constexpr unsigned nameOffsetSlot(unsigned roleMask, TextRole role)
+    {
+        return std::popcount(roleMask & ~textRoleBit(TextRole::MAIN_NAME)
+                                      & (textRoleBit(role) - 1));
+    }
 
     enum {
         INSTEAD_REVERT = '1',
@@ -0,0 +1,145 @@
+// My header
+#include "UcPack.h"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+    template <class T>
+    inline uc::pack::Bytes bytesOf(const T& x)
+        { return { reinterpret_cast<const unsigned char*>(&x), sizeof(T) }; }
+
+    uint64_t sumHeader(const uc::pack::Header& header,
+                       std::span<const uc::pack::Section> sections)
+    {
+        auto h = uc::pack::hashSum(bytesOf(header.magic));
+        h = uc::pack::hashSum(bytesOf(header.formatVersion), h);
+        h = uc::pack::hashSum(bytesOf(header.nSections), h);
+        h = uc::pack::hashSum(bytesOf(header.stamp), h);
+        uc::pack::Bytes table {
+                reinterpret_cast<const unsigned char*>(sections.data()),
+                sections.size_bytes() };
+        return uc::pack::hashSum(table, h);
+    }
+
+    constexpr uint64_t alignUp(uint64_t x)
+        { return (x + uc::pack::SEC_ALIGN - 1) / uc::pack::SEC_ALIGN * uc::pack::SEC_ALIGN; }
+
+}   // anon namespace
+
+
+uint64_t uc::pack::hashSum(Bytes data, uint64_t h)
+{
+    for (auto c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+
+///// View /////////////////////////////////////////////////////////////////////
+
+
+bool uc::pack::View::open(Bytes aFile, uint64_t stamp)
+{
+    file = {};
+    sections = {};
+    if (aFile.size() < sizeof(Header)
+            || reinterpret_cast<uintptr_t>(aFile.data()) % alignof(Header) != 0)
+        return false;
+    auto& header = *reinterpret_cast<const Header*>(aFile.data());
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+            || header.formatVersion != FORMAT_VERSION
+            || header.stamp != stamp
+            || header.nSections > (aFile.size() - sizeof(Header)) / sizeof(Section))
+        return false;
+    std::span<const Section> secs {
+            reinterpret_cast<const Section*>(aFile.data() + sizeof(Header)),
+            header.nSections };
+    if (header.headerSum != sumHeader(header, secs))
+        return false;
+    for (auto& v : secs) {
+        if (v.offset % SEC_ALIGN != 0 || v.offset > aFile.size()
+                || v.size > aFile.size() - v.offset)
+            return false;
+    }
+    file = aFile;
+    sections = secs;
+    return true;
+}
+
+
+uc::pack::Bytes uc::pack::View::section(SecId id) const
+{
+    for (auto& v : sections) {
+        if (v.id == id)
+            return file.subspan(v.offset, v.size);
+    }
+    return {};
+}
+
+
+bool uc::pack::View::verify() const
+{
+    return std::all_of(sections.begin(), sections.end(),
+            [this](const Section& v) {
+                return hashSum(file.subspan(v.offset, v.size)) == v.sum;
+            });
+}
+
+
+///// Builder //////////////////////////////////////////////////////////////////
+
+
+void uc::pack::Builder::add(SecId id, Bytes data)
+{
+    for (auto& v : secs) {
+        if (v.id == id)
+            throw std::logic_error("Data pack: section repeats");
+    }
+    secs.push_back({ .id = id,
+                     .data { data.begin(), data.end() },
+                     .sum = hashSum(data) });
+}
+
+
+uint64_t uc::pack::Builder::stamp() const
+{
+    auto h = HASH_BASIS;
+    for (auto& v : secs) {
+        h = hashSum(bytesOf(v.id), h);
+        h = hashSum(bytesOf(v.sum), h);
+    }
+    return h;
+}
+
+
+std::vector<unsigned char> uc::pack::Builder::build() const
+{
+    Header header {};
+    std::copy(std::begin(MAGIC), std::end(MAGIC), header.magic);
+    header.formatVersion = FORMAT_VERSION;
+    header.nSections = secs.size();
+    header.stamp = stamp();
+
+    std::vector<Section> table;
+    uint64_t pos = alignUp(sizeof(Header) + secs.size() * sizeof(Section));
+    for (auto& v : secs) {
+        table.push_back({ .id = v.id, .reserved = 0, .offset = pos,
+                          .size = v.data.size(), .sum = v.sum });
+        pos = alignUp(pos + v.data.size());
+    }
+    header.headerSum = sumHeader(header, table);
+
+    std::vector<unsigned char> r(pos, 0);
+    memcpy(r.data(), &header, sizeof(Header));
+    if (!table.empty())
+        memcpy(r.data() + sizeof(Header), table.data(), table.size() * sizeof(Section));
+    for (size_t i = 0; i < secs.size(); ++i)
+        std::copy(secs[i].data.begin(), secs[i].data.end(), r.begin() + table[i].offset);
+    return r;
+}
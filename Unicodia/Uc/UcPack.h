@@ -0,0 +1,94 @@
+#pragma once
+
+///
+/// Binary data pack: Unicode tables outside the executable.
+/// Common for AutoBuilder (builds) and Unicodia (maps at startup,
+/// w/o parsing). The pack is optional: if it’s absent or does not fit,
+/// tables embedded from UcAuto*.cpp are used. UC_PACK_ONLY (qmake
+/// CONFIG+=uc_pack_only) drops those embedded tables, the pack is required.
+///
+
+// STL
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace uc::pack {
+
+    ///  File layout: Header, Section[nSections], section data,
+    ///  every section aligned to SEC_ALIGN.
+    ///  Numbers are native little-endian, a pack of other byte order
+    ///  fails on formatVersion.
+    constexpr char MAGIC[8] { 'U', 'c', 'P', 'a', 'c', 'k', '\r', '\n' };
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr uint64_t SEC_ALIGN = 64;
+    constexpr const char* FNAME = "UcData.pack";
+
+    enum class SecId : uint32_t {
+        STRINGS = 1,    ///< uc::allStrings
+        SUTTON = 2,     ///< sw::data
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t nSections;
+        uint64_t stamp;         ///< same as uc::PACK_STAMP of UcAuto.cpp made together
+        uint64_t headerSum;     ///< hashSum of the rest of header, and of section table
+    };
+
+    struct Section {
+        SecId id;
+        uint32_t reserved;
+        uint64_t offset, size;  ///< bytes from file start
+        uint64_t sum;           ///< hashSum of data
+    };
+
+    using Bytes = std::span<const unsigned char>;
+
+    constexpr uint64_t HASH_BASIS = 14695981039346656037ull;
+
+    /// FNV-1a, 64-bit
+    uint64_t hashSum(Bytes data, uint64_t h = HASH_BASIS);
+
+    ///
+    ///  Pack in memory. Opening checks header and section table only,
+    ///  so mapped data is paged in lazily
+    ///
+    class View
+    {
+    public:
+        /// @param [in] stamp  what we expect: uc::PACK_STAMP
+        /// @return [+] header and section table are OK, sections fit into file
+        bool open(Bytes aFile, uint64_t stamp);
+        /// @return  section data, empty if no such section
+        Bytes section(SecId id) const;
+        /// Reads everything
+        /// @return [+] every section matches its sum
+        bool verify() const;
+    private:
+        Bytes file;
+        std::span<const Section> sections;
+    };
+
+    ///
+    ///  Makes pack, for AutoBuilder
+    ///
+    class Builder
+    {
+    public:
+        /// @throw logic_error  section repeats
+        void add(SecId id, Bytes data);
+        /// @return  stamp of data: pack goes only with UcAuto.cpp of the same stamp
+        uint64_t stamp() const;
+        std::vector<unsigned char> build() const;
+    private:
+        struct Sec {
+            SecId id;
+            std::vector<unsigned char> data;
+            uint64_t sum;
+        };
+        std::vector<Sec> secs;
+    };
+
+}   // namespace uc::pack
@@ -18,6 +18,19 @@ DEFINES += QT_DEPRECATED_WARNINGS QT_STRINGS
 
 CONFIG(debug, debug|release) {
     DEFINES += AT_RANGE_CHECK
+    # completeData recounts what AutoBuilder made
+    DEFINES += UC_VERIFY_DATA
+}
+
+# qmake CONFIG+=uc_pack_only: tables moved to UcData.pack are not embedded,
+#   the pack is required then
+uc_pack_only {
+    DEFINES += UC_PACK_ONLY
+}
+
+# qmake CONFIG+=bench_allocs: Unicodia --bench-search also counts allocations
+bench_allocs {
+    DEFINES += SEARCH_BENCH_ALLOCS
 }
 
 # You can also make your code fail to compile if it uses deprecated APIs.
@@ -42,9 +55,21 @@ SOURCES += \
     CharPaint/routines.cpp \
     CharPaint/IconEngines.cpp \
     CharPaint/emoji.cpp \
+    Search/arena.cpp \
+    Search/bench.cpp \
+    Search/benchRun.cpp \
+    Search/bitmap.cpp \
     Search/engine.cpp \
+    Search/executor.cpp \
+    Search/fold.cpp \
+    Search/fuzzy.cpp \
+    Search/index.cpp \
+    Search/matcher.cpp \
+    Search/mnemonic.cpp \
     Search/nonAscii.cpp \
+    Search/pattern.cpp \
     Search/request.cpp \
+    Search/session.cpp \
     Search/uc.cpp \
     FmMessage.cpp \
     FmTofuStats.cpp \
@@ -52,6 +77,7 @@ SOURCES += \
     MainGui.cpp \
     Uc/UcAuto.cpp \
     ../Libs/SelfMade/c_TableCache.cpp \
+    ../Libs/SelfMade/Fonts/CompressedBits.cpp \
     ../Libs/SelfMade/Fonts/TempFont.cpp \
     ../Libs/SelfMade/i_MemStream.cpp \
     ../Libs/SelfMade/Strings/u_Decoders.cpp \
@@ -69,6 +95,7 @@ SOURCES += \
     Uc/UcData.cpp \
     Uc/UcDating.cpp \
     Uc/UcFonts.cpp \
+    Uc/UcPack.cpp \
     Uc/UcScripts.cpp \
     WiLibCp.cpp \
     WiOsStyle.cpp \
@@ -88,6 +115,7 @@ HEADERS += \
     ../Libs/PugiXml/pugiconfig.hpp \
     ../Libs/PugiXml/pugixml.hpp \
     ../Libs/SelfMade/Fonts/MemFont.h \
+    ../Libs/SelfMade/Fonts/CompressedBits.h \
     ../Libs/SelfMade/Fonts/TempFont.h \
     ../Libs/SelfMade/GitHub/parsers.h \
     ../Libs/SelfMade/Mojibake/mojibake.h \
@@ -118,9 +146,23 @@ HEADERS += \
     CharPaint/global.h \
     CharPaint/emoji.h \
     Search/defs.h \
+    Search/arena.h \
+    Search/bench.h \
+    Search/benchRun.h \
+    Search/bitmap.h \
     Search/engine.h \
+    Search/executor.h \
+    Search/fold.h \
+    Search/fuzzy.h \
+    Search/index.h \
+    Search/lru.h \
+    Search/matcher.h \
+    Search/mnemonic.h \
     Search/nonAscii.h \
+    Search/pattern.h \
     Search/request.h \
+    Search/session.h \
+    Search/shards.h \
     Search/trie.h \
     Search/uc.h \
     FmMain.h \
@@ -142,6 +184,7 @@ HEADERS += \
     Uc/UcData.h \
     Uc/UcDating.h \
     Uc/UcFlags.h \
+    Uc/UcPack.h \
     Uc/UcSkin.h \
     WiLibCp.h \
     WiOsStyle.h \
@@ -35,6 +35,7 @@ std::string updatever::equivPlatforms { EQUIV_PLATFORMS };
 // fname
 std::filesystem::path fname::config;
 std::filesystem::path fname::progsets;
+std::filesystem::path fname::fontCoverage;
 
 // path
 std::filesystem::path path::exeBundled;
@@ -51,6 +52,7 @@ config::Favs config::favs;
 
 constexpr std::string_view APP_XML = APP_NAME ".xml";
 constexpr std::string_view CONFIG_NAME = "config.xml";
+constexpr std::string_view FONT_COVERAGE_NAME = "fontcoverage.bin";
 
 ///// Favs /////////////////////////////////////////////////////////////////////
 
@@ -200,6 +202,7 @@ void config::init(QRect& winRect, BlockOrder& blockOrder)
         break;
     }
     fname::config = path::config / CONFIG_NAME;
+    fname::fontCoverage = path::config / FONT_COVERAGE_NAME;
     loadConfig(winRect, blockOrder);
 }
 
@@ -41,6 +41,8 @@ namespace updatever {
 namespace fname {
     extern std::filesystem::path config;
     extern std::filesystem::path progsets;
+    // Cache of bundled fonts’ cmaps, see TempFont.h
+    extern std::filesystem::path fontCoverage;
 }
 
 namespace path {
@@ -1,5 +1,6 @@
 // Qt
 #include <QApplication>
+#include <QMessageBox>
 #include <QWidget>
 #include <QTranslator>
 
@@ -13,9 +14,15 @@
 #include "LocList.h"
 #include "LocManager.h"
 
+// Unicode
+#include "UcPack.h"
+
 // Qt forms
 #include "FmMain.h"
 
+// Search
+#include "Search/benchRun.h"
+
 namespace {
 
     ///
@@ -37,6 +44,7 @@ namespace {
                     loc::currLang->sortOrder,
                     loc::currLang->ellipsis.blocks,
                     loc::currLang->alphaFixup);
+        uc::buildLocSearch(!loc::currLang->hasMainLang("en"));
         mywiki::translateDatingLoc();
     }
 
@@ -60,9 +68,27 @@ int main(int argc, char *argv[])
     QApplication a(argc, argv);
     //a.setStyle("fusion");
 
+    auto packName = QApplication::applicationDirPath() + '/' + uc::pack::FNAME;
+#ifdef UC_PACK_ONLY
+    if (!uc::mapDataPack(packName)) {
+        // L10n is not loaded yet
+        QMessageBox::critical(nullptr, "Unicodia",
+                "Cannot load " + packName + ", it is missing or made for another version.");
+        return 1;
+    }
+#else
+    uc::mapDataPack(packName);
+#endif
     uc::completeData();  // …runs once and should not depend on L10n
     initTranslation();
 
+    // Search benchmark: Unicodia --bench-search [file.jsonl [nRuns]]
+    if (auto args = a.arguments(); args.size() >= 2 && args[1] == "--bench-search") {
+        auto fname = args.value(2, "search-bench.jsonl");
+        auto nRuns = args.value(3, "100").toUInt();
+        return uc::runSearchBench(fname.toStdWString(), std::max(nRuns, 1u));
+    }
+
     FmMain w;
     w.installTempPrefix();
     loc::man.add(w);
@@ -73,6 +99,7 @@ int main(int argc, char *argv[])
         auto rect = w.geometry();
 
         config::init(rect, order);
+        loadFontCoverage(fname::fontCoverage);
 
         w.chooseFirstLanguage();
         w.setBlockOrder(order);  // Strange interaction: first language, then order, not vice-versa
@@ -89,6 +116,7 @@ int main(int argc, char *argv[])
     { loc::AutoStop autoStop;
         int r = a.exec();
         config::save(w.normalGeometry(), w.isMaximized(), w.blockOrder());
+        saveFontCoverage();
         return r;
     }   // manager will stop erasing here → speed up exit
 }
@@ -15,15 +15,31 @@ SOURCES += \
     ../Libs/GoogleTest/src/gtest-all.cc \
     ../Libs/GoogleTest/src/gtest_main.cc \
     ../Libs/L10n/LocFmt.cpp \
+    ../Libs/SelfMade/Fonts/CompressedBits.cpp \
     ../Libs/SelfMade/Strings/u_Strings.cpp \
     ../Libs/SelfMade/u_Version.cpp \
+    ../Unicodia/Search/arena.cpp \
+    ../Unicodia/Search/bench.cpp \
+    ../Unicodia/Search/bitmap.cpp \
     ../Unicodia/Search/engine.cpp \
+    ../Unicodia/Search/fold.cpp \
+    ../Unicodia/Search/fuzzy.cpp \
+    ../Unicodia/Search/index.cpp \
+    ../Unicodia/Search/matcher.cpp \
+    ../Unicodia/Search/mnemonic.cpp \
+    ../Unicodia/Search/pattern.cpp \
+    ../Unicodia/Search/session.cpp \
+    ../Unicodia/Uc/UcPack.cpp \
     ../Unicodia/Wiki.cpp \
+    test_CompressedBits.cpp \
     test_Decapitalize.cpp \
     test_DumbSp.cpp \
     test_Fmt.cpp \
     test_Forget.cpp \
+    test_Index.cpp \
     test_Iterator.cpp \
+    test_Matcher.cpp \
+    test_Pack.cpp \
     test_Search.cpp \
     test_Strings.cpp \
     test_Trie.cpp \
@@ -34,13 +50,28 @@ HEADERS += \
     ../AutoBuilder/data.h \
     ../AutoBuilder/forget.h \
     ../Libs/L10n/LocFmt.h \
+    ../Libs/SelfMade/Fonts/CompressedBits.h \
     ../Libs/SelfMade/u_Iterator.h \
     ../Libs/SelfMade/Strings/u_Strings.h \
     ../Libs/SelfMade/u_Version.h \
+    ../Unicodia/Search/arena.h \
+    ../Unicodia/Search/bench.h \
+    ../Unicodia/Search/bitmap.h \
     ../Unicodia/Search/engine.h \
+    ../Unicodia/Search/fold.h \
+    ../Unicodia/Search/fuzzy.h \
+    ../Unicodia/Search/index.h \
+    ../Unicodia/Search/lru.h \
+    ../Unicodia/Search/matcher.h \
+    ../Unicodia/Search/mnemonic.h \
+    ../Unicodia/Search/pattern.h \
+    ../Unicodia/Search/session.h \
     ../Unicodia/Search/trie.h \
+    ../Unicodia/Uc/UcPack.h \
     ../Unicodia/Wiki.h
 
+DEFINES += RAWDATA_DIR=\\\"$$PWD/../MiscFiles/RawData/\\\"
+
 INCLUDEPATH += \
     ../AutoBuilder \
     ../Libs/GoogleTest \
@@ -0,0 +1,85 @@
+// What we are testing
+#include "Fonts/CompressedBits.h"
+
+// STL
+#include <sstream>
+
+// Google test
+#include "gtest/gtest.h"
+
+namespace {
+
+    CompressedBits makeBits()
+    {
+        CompressedBits r;
+        r.add(0x41);
+        r.add(0x3000);
+        r.add(0x10FFFD);
+        return r;
+    }
+
+}   // anon namespace
+
+
+///
+///  What’s written is read back
+///
+TEST (CompressedBits, RoundTrip)
+{
+    std::stringstream ss;
+    makeBits().write(ss);
+
+    CompressedBits r;
+    ASSERT_TRUE(r.read(ss));
+    EXPECT_TRUE(r.have(0x41));
+    EXPECT_TRUE(r.have(0x3000));
+    EXPECT_TRUE(r.have(0x10FFFD));
+    EXPECT_FALSE(r.have(0x42));
+    EXPECT_FALSE(r.have(0x3001));
+    EXPECT_FALSE(r.have(0x10FFFE));
+}
+
+
+///
+///  Empty set is written and read back empty
+///
+TEST (CompressedBits, RoundTripEmpty)
+{
+    std::stringstream ss;
+    CompressedBits().write(ss);
+
+    auto r = makeBits();
+    ASSERT_TRUE(r.read(ss));
+    EXPECT_TRUE(r.isEmpty());
+}
+
+
+///
+///  Truncated data → false, object is empty
+///
+TEST (CompressedBits, Truncated)
+{
+    std::stringstream ss;
+    makeBits().write(ss);
+    auto s = ss.str();
+    std::stringstream ss1(s.substr(0, s.size() - 1));
+
+    auto r = makeBits();
+    EXPECT_FALSE(r.read(ss1));
+    EXPECT_TRUE(r.isEmpty());
+    EXPECT_FALSE(r.have(0x41));
+}
+
+
+///
+///  Copy is deep
+///
+TEST (CompressedBits, Copy)
+{
+    auto x = makeBits();
+    CompressedBits y = x;
+    y.add(0x42);
+    EXPECT_TRUE(y.have(0x41));
+    EXPECT_TRUE(y.have(0x42));
+    EXPECT_FALSE(x.have(0x42));
+}
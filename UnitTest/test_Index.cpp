@@ -0,0 +1,443 @@
+// What we are testing
+#include "Search/arena.h"
+#include "Search/bitmap.h"
+#include "Search/fuzzy.h"
+#include "Search/index.h"
+#include "Search/lru.h"
+#include "Search/matcher.h"
+#include "Search/mnemonic.h"
+#include "Search/session.h"
+
+// Google test
+#include "gtest/gtest.h"
+
+namespace {
+
+    SafeVector<srh::HayId> toVector(const srh::IdSet& x)
+    {
+        SafeVector<srh::HayId> r;
+        x.forEach([&r](srh::HayId id) { r.push_back(id); });
+        return r;
+    }
+
+    SafeVector<srh::HayId> findCandidates(
+            const srh::WordIndex& index, std::u8string_view what)
+    {
+        srh::Needle needle(what);
+        srh::IdSet r;
+        r.reset(index.nIds());
+        index.findCandidates(needle, r);
+        return toVector(r);
+    }
+
+    srh::WordIndex makeIndex()
+    {
+        srh::WordIndex r;
+        r.add(0, u8"LATIN CAPITAL LETTER A");
+        r.add(1, u8"LATIN SMALL LETTER A");
+        r.add(1, u8"LATIN SMALL LETTER A (ALIAS)");
+        r.add(65, u8"CYRILLIC SMALL LETTER A");
+        r.add(130, u8"GRINNING FACE");
+        r.finish(200);
+        return r;
+    }
+
+}   // anon namespace
+
+
+///// IdSet ////////////////////////////////////////////////////////////////////
+
+
+TEST (IdSet, Simple)
+{
+    srh::IdSet s;
+    s.reset(200);
+    EXPECT_EQ(200u, s.capacity());
+    EXPECT_TRUE(s.isEmpty());
+    s.add(130);
+    s.add(0);
+    s.add(64);
+    s.add(63);
+    EXPECT_FALSE(s.isEmpty());
+    EXPECT_TRUE(s.contains(63));
+    EXPECT_FALSE(s.contains(62));
+    EXPECT_FALSE(s.contains(1000));
+    SafeVector<srh::HayId> expected { 0, 63, 64, 130 };
+    EXPECT_EQ(expected, toVector(s));
+}
+
+
+///// WordIndex ////////////////////////////////////////////////////////////////
+
+
+///
+///  Whole words, and postings are not duplicated
+///
+TEST (WordIndex, WholeWords)
+{
+    auto index = makeIndex();
+    EXPECT_TRUE(index.isFinished());
+    EXPECT_EQ(200u, index.nIds());
+    SafeVector<srh::HayId> expected { 1, 65 };
+    EXPECT_EQ(expected, findCandidates(index, u8"small"));
+}
+
+
+///
+///  Substrings, and word borders are not crossed
+///
+TEST (WordIndex, Substrings)
+{
+    auto index = makeIndex();
+    SafeVector<srh::HayId> expected1 { 0 };
+    EXPECT_EQ(expected1, findCandidates(index, u8"apit"));
+    SafeVector<srh::HayId> expected2 { 130 };
+    EXPECT_EQ(expected2, findCandidates(index, u8"ace"));
+    EXPECT_TRUE(findCandidates(index, u8"ERA").empty());    // lettER A
+}
+
+
+///
+///  Any of needle words is enough
+///
+TEST (WordIndex, AnyWord)
+{
+    auto index = makeIndex();
+    SafeVector<srh::HayId> expected { 1, 65, 130 };
+    EXPECT_EQ(expected, findCandidates(index, u8"grin, cyr alias"));
+}
+
+
+///// HayArena /////////////////////////////////////////////////////////////////
+
+
+///
+///  Names go to their IDs, prepared and split
+///
+TEST (HayArena, Simple)
+{
+    srh::HayArena arena;
+    arena.add(1, u8"latin small letter a", srh::DefaultComparator::INST);
+    arena.add(1, u8"&aacute;", srh::DefaultComparator::INST);
+    arena.add(3, u8"grinning face", srh::DefaultComparator::INST);
+    arena.add(3, u8"#1", srh::DefaultComparator::INST);
+    arena.finish(5);
+
+    EXPECT_EQ(5u, arena.nIds());
+    EXPECT_TRUE(arena.names(0).empty());
+    EXPECT_TRUE(arena.names(2).empty());
+    EXPECT_TRUE(arena.names(4).empty());
+
+    auto names1 = arena.names(1);
+    ASSERT_EQ(2u, names1.size());
+    EXPECT_TRUE(u8"latin small letter a" == names1[0].value);
+    EXPECT_TRUE(u8"LATIN SMALL LETTER A" == arena.prepared(names1[0]));
+    EXPECT_FALSE(names1[0].isMnemonic);
+    EXPECT_TRUE(names1[0].isKeyword);
+    auto words = arena.words(names1[0]);
+    ASSERT_EQ(4u, words.size());
+    EXPECT_TRUE(u8"SMALL" == words[1].sv());
+    EXPECT_TRUE(u8"LETTER" == words[2].sv());
+    EXPECT_EQ(srh::HaystackClass::SCRIPT, words[2].lowPrioClass);
+    EXPECT_TRUE(names1[1].isMnemonic);
+
+    auto names3 = arena.names(3);
+    ASSERT_EQ(2u, names3.size());
+    EXPECT_EQ(2u, arena.words(names3[0]).size());
+    EXPECT_FALSE(names3[1].isKeyword);
+}
+
+
+///
+///  Search over arena gives the same as over string
+///
+TEST (HayArena, FindNeedle)
+{
+    srh::HayArena arena;
+    arena.add(0, u8"Latin small letter A", srh::DefaultComparator::INST);
+    arena.finish(1);
+    auto& name = arena.names(0)[0];
+
+    srh::Needle needle(u8"lat lett");
+    srh::Cache cache;
+    auto prio1 = srh::findNeedle(arena.words(name), needle,
+                    srh::HaystackClass::SCRIPT, srh::DefaultComparator::INST);
+    auto prio2 = srh::findNeedle(name.value, needle,
+                    srh::HaystackClass::SCRIPT, cache, srh::DefaultComparator::INST);
+    EXPECT_TRUE(prio2 == prio1);
+    EXPECT_EQ(2, prio1.initial + prio1.initialScript);
+}
+
+
+///// Session //////////////////////////////////////////////////////////////////
+
+
+namespace {
+
+    struct ArenaIndex {
+        srh::HayArena arena;
+        srh::WordIndex index;
+
+        ArenaIndex();
+    };
+
+    ArenaIndex::ArenaIndex()
+    {
+        arena.add(0, u8"LATIN CAPITAL LETTER A", srh::DefaultComparator::INST);
+        arena.add(1, u8"LATIN SMALL LETTER A", srh::DefaultComparator::INST);
+        arena.add(2, u8"LATERAL CLICK", srh::DefaultComparator::INST);
+        arena.add(3, u8"PLATINUM #1", srh::DefaultComparator::INST);
+        arena.add(4, u8"GRINNING FACE", srh::DefaultComparator::INST);
+        arena.finish(5);
+        for (srh::HayId id = 0; id < arena.nIds(); ++id) {
+            for (auto& nm : arena.names(id)) {
+                if (nm.isIndexed())
+                    index.add(id, arena.prepared(nm));
+            }
+        }
+        index.finish(arena.nIds());
+    }
+
+    SafeVector<srh::HayId> sessionFind(
+            const ArenaIndex& ai, srh::Session& session,
+            std::u8string_view what, bool expectedRefined)
+    {
+        srh::Needle needle(what);
+        srh::IdSet r;
+        EXPECT_EQ(expectedRefined, session.findCandidates(ai.arena, ai.index, needle, r));
+        return toVector(r);
+    }
+
+}   // anon namespace
+
+
+///
+///  lat → lati → latin: refining, and results are the same as from scratch
+///
+TEST (Session, Refine)
+{
+    ArenaIndex ai;
+    srh::Session session;
+    SafeVector<srh::HayId> expected1 { 0, 1, 2 };
+    EXPECT_EQ(expected1, sessionFind(ai, session, u8"lat", false));
+    SafeVector<srh::HayId> expected2 { 0, 1 };
+    EXPECT_EQ(expected2, sessionFind(ai, session, u8"lati", true));
+    EXPECT_EQ(expected2, sessionFind(ai, session, u8"latin", true));
+}
+
+
+///
+///  Not a refinement → from scratch
+///
+TEST (Session, NotRefine)
+{
+    ArenaIndex ai;
+    srh::Session session;
+    SafeVector<srh::HayId> expected1 { 0, 1 };
+    EXPECT_EQ(expected1, sessionFind(ai, session, u8"latin", false));
+    SafeVector<srh::HayId> expected2 { 0, 1, 2 };
+    EXPECT_EQ(expected2, sessionFind(ai, session, u8"lat", false));
+    SafeVector<srh::HayId> expected3 { 0, 1, 4 };
+    EXPECT_EQ(expected3, sessionFind(ai, session, u8"latin face", false));
+    session.clear();
+    EXPECT_EQ(expected1, sessionFind(ai, session, u8"latin", false));
+}
+
+
+///
+///  Mnemonics: exact and case-insensitive, exact wins within haystack
+///
+TEST (MnemonicIndex, Find)
+{
+    srh::MnemonicIndex index;
+    index.add(1, 0, u8"&dagger;");
+    index.add(2, 0, u8"&Dagger;");
+    index.add(2, 1, u8"&ddagger;");
+    index.add(3, 0, u8"&DAGGER;");
+    index.add(3, 1, u8"&dagger;");
+    EXPECT_EQ(5u, index.size());
+
+    SafeVector<srh::MnemonicIndex::Hit> r;
+    index.find(u8"&dagger;", r);
+    ASSERT_EQ(3u, r.size());
+    EXPECT_EQ(1u, r[0].id);  EXPECT_EQ(0, r[0].iName);  EXPECT_TRUE(r[0].isExact);
+    EXPECT_EQ(2u, r[1].id);  EXPECT_EQ(0, r[1].iName);  EXPECT_FALSE(r[1].isExact);
+    EXPECT_EQ(3u, r[2].id);  EXPECT_EQ(1, r[2].iName);  EXPECT_TRUE(r[2].isExact);
+
+    index.find(u8"&DDAGGER;", r);
+    ASSERT_EQ(1u, r.size());
+    EXPECT_EQ(2u, r[0].id);  EXPECT_EQ(1, r[0].iName);  EXPECT_FALSE(r[0].isExact);
+
+    index.find(u8"&amp;", r);
+    EXPECT_TRUE(r.empty());
+}
+
+
+///
+///  Run bitmap: building, AND, OR
+///
+TEST (RunBitmap, Simple)
+{
+    srh::RunBitmap x;
+    for (srh::HayId id : { 1, 2, 3, 5, 10, 11 })
+        x.add(id);
+    SafeVector<srh::RunBitmap::Run> expected { { 1, 4 }, { 5, 6 }, { 10, 12 } };
+    EXPECT_TRUE(std::ranges::equal(expected, x.runs()));
+    EXPECT_EQ(6u, x.count());
+    EXPECT_FALSE(x.contains(0));
+    EXPECT_TRUE(x.contains(3));
+    EXPECT_FALSE(x.contains(4));
+    EXPECT_TRUE(x.contains(11));
+    EXPECT_FALSE(x.contains(12));
+
+    SafeVector<srh::HayId> ids;
+    x.forEach([&ids](srh::HayId id) { ids.push_back(id); });
+    SafeVector<srh::HayId> expectedIds { 1, 2, 3, 5, 10, 11 };
+    EXPECT_EQ(expectedIds, ids);
+}
+
+
+TEST (RunBitmap, AndOr)
+{
+    srh::RunBitmap x, y;
+    x.addRun(0, 10);
+    x.addRun(20, 30);
+    y.addRun(5, 22);
+    y.addRun(29, 40);
+
+    auto a = x & y;
+    SafeVector<srh::RunBitmap::Run> expectedA { { 5, 10 }, { 20, 22 }, { 29, 30 } };
+    EXPECT_TRUE(std::ranges::equal(expectedA, a.runs()));
+
+    auto o = x | y;
+    SafeVector<srh::RunBitmap::Run> expectedO { { 0, 40 } };
+    EXPECT_TRUE(std::ranges::equal(expectedO, o.runs()));
+
+    // Touching runs merge
+    srh::RunBitmap z;
+    z.addRun(40, 50);
+    auto o2 = o | z;
+    EXPECT_EQ(1u, o2.runs().size());
+    EXPECT_EQ(50u, o2.count());
+
+    EXPECT_TRUE((x & srh::RunBitmap{}).isEmpty());
+    EXPECT_EQ(x, x | srh::RunBitmap{});
+    EXPECT_EQ(x, x & srh::RunBitmap::all(100));
+}
+
+
+///
+///  Levenshtein automaton: distances of typical typos
+///
+TEST (Fuzzy, Automaton)
+{
+    auto dist = [](std::u8string_view word, std::u8string_view typo) -> int {
+        srh::LevenshteinAutomaton automaton(typo, 2);
+        auto state = automaton.start();
+        for (auto c : word) {
+            state = automaton.step(state, c);
+            if (!automaton.canMatch(state))
+                return -1;
+        }
+        return automaton.isMatch(state) ? automaton.distance(state) : -1;
+    };
+    EXPECT_EQ(0, dist(u8"ACUTE", u8"ACUTE"));
+    EXPECT_EQ(1, dist(u8"ACUTE", u8"ACCUTE"));
+    EXPECT_EQ(1, dist(u8"CYRILLIC", u8"CYRILIC"));
+    EXPECT_EQ(2, dist(u8"GRINNING", u8"GRINNIGN"));
+    EXPECT_EQ(1, dist(u8"LATIN", u8"LATN"));
+    EXPECT_EQ(-1, dist(u8"LATIN", u8"LETTER"));
+
+    EXPECT_EQ(0u, srh::maxTypos(3));
+    EXPECT_EQ(1u, srh::maxTypos(5));
+    EXPECT_EQ(2u, srh::maxTypos(8));
+}
+
+
+///
+///  Fuzzy words are found only for needle words found nowhere
+///
+TEST (Fuzzy, Candidates)
+{
+    auto index = makeIndex();
+    srh::Needle needle(u8"cyrilic smal");
+    index.addFuzzyWords(needle);
+    ASSERT_EQ(1u, needle.words[0].fuzzyWords.size());
+    EXPECT_TRUE(needle.words[0].fuzzyWords[0] == u8"CYRILLIC");
+    EXPECT_TRUE(needle.words[1].fuzzyWords.empty());    // substring of SMALL
+
+    srh::IdSet r;
+    r.reset(index.nIds());
+    index.findCandidates(needle, r);
+    SafeVector<srh::HayId> expected { 1, 65 };
+    EXPECT_EQ(expected, toVector(r));
+
+    srh::Needle needle2(u8"grining faec");
+    index.addFuzzyWords(needle2);
+    ASSERT_EQ(1u, needle2.words[0].fuzzyWords.size());
+    EXPECT_TRUE(needle2.words[0].fuzzyWords[0] == u8"GRINNING");
+    EXPECT_TRUE(needle2.words[1].fuzzyWords.empty());   // too short for typos
+}
+
+
+///
+///  Fuzzy hit is the lowest place: below partial
+///
+TEST (Fuzzy, Prio)
+{
+    auto index = makeIndex();
+    srh::HayArena arena;
+    arena.add(0, u8"Cyrillic small letter A", srh::DefaultComparator::INST);
+    arena.finish(1);
+    auto& name = arena.names(0)[0];
+
+    srh::Needle needle(u8"cyrilic");
+    index.addFuzzyWords(needle);
+    auto prio1 = srh::findNeedle(arena.words(name), needle,
+                    srh::HaystackClass::SCRIPT, srh::DefaultComparator::INST);
+    EXPECT_EQ(1, prio1.fuzzy);
+    EXPECT_EQ(0, prio1.partial);
+    auto prio2 = srh::findNeedle(srh::Kernel::SCALAR, arena.prepared(name), arena.words(name),
+                    needle, srh::HaystackClass::SCRIPT);
+    EXPECT_TRUE(prio2 == prio1);
+
+    srh::Needle needle2(u8"rill");
+    auto prio3 = srh::findNeedle(arena.words(name), needle2,
+                    srh::HaystackClass::SCRIPT, srh::DefaultComparator::INST);
+    EXPECT_TRUE(prio3 > prio1);
+    EXPECT_TRUE(prio1 > srh::Prio::EMPTY);
+}
+
+
+///
+///  LRU cache: eviction by size and weight, hits/misses
+///
+TEST (LruCache, Simple)
+{
+    srh::LruCache<std::u8string, int> cache(3, 100);
+    cache.put(u8"a", 1);
+    cache.put(u8"b", 2);
+    cache.put(u8"c", 3);
+    ASSERT_NE(nullptr, cache.find(u8"a"));      // a is the most recent now
+    cache.put(u8"d", 4);                        // b goes away
+    EXPECT_EQ(nullptr, cache.find(u8"b"));
+    ASSERT_NE(nullptr, cache.find(u8"a"));
+    EXPECT_EQ(1, *cache.find(u8"a"));
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_EQ(3u, cache.nHits());
+    EXPECT_EQ(1u, cache.nMisses());
+
+    cache.put(u8"e", 5, 99);                    // all but a go away
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_EQ(100u, cache.weight());
+    EXPECT_EQ(nullptr, cache.find(u8"c"));
+    cache.put(u8"f", 6, 101);                   // too heavy
+    EXPECT_EQ(nullptr, cache.find(u8"f"));
+    cache.put(u8"e", 7, 50);                    // replace
+    EXPECT_EQ(7, *cache.find(u8"e"));
+    EXPECT_EQ(51u, cache.weight());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(nullptr, cache.find(u8"a"));
+}
@@ -0,0 +1,215 @@
+// What we are testing
+#include "Search/matcher.h"
+
+// Google test
+#include "gtest/gtest.h"
+
+// STL
+#include <chrono>
+#include <random>
+
+// Search
+#include "Search/arena.h"
+#include "Search/fold.h"
+
+namespace {
+
+    constexpr std::u8string_view NAMES[] {
+        u8"LATIN CAPITAL LETTER A",
+        u8"LATIN SMALL LETTER A WITH RING ABOVE",
+        u8"CYRILLIC SMALL LETTER BIG YUS",
+        u8"GRINNING FACE WITH SMILING EYES",
+        u8"BANANA",                     // several occurrences in word
+        u8"X-RAY, (ALPHA:BETA)",        // other separators, non-letter before
+        u8"SIGN OF THE CROSS",
+        u8"ABCABCABCABCABCABCABCABCABCABCABCABCABCABCABCABCABCABCABCABC ABC",
+    };
+
+    constexpr std::u8string_view NEEDLES[] {
+        u8"a", u8"latin", u8"letter", u8"lett", u8"small a", u8"ana",
+        u8"nan", u8"ray", u8"x-ray", u8"-ray", u8"beta", u8"alpha beta",
+        u8"sign", u8"of", u8"cross sign", u8"abc", u8"cab", u8"zzz",
+        u8"yus big", u8"e", u8"with", u8"ithi",
+    };
+
+    std::string_view toChar(std::u8string_view x)
+        { return { reinterpret_cast<const char*>(x.data()), x.size() }; }
+
+    struct Hay {
+        srh::HayArena arena;
+        Hay();
+    };
+
+    Hay::Hay()
+    {
+        for (size_t i = 0; i < std::size(NAMES); ++i)
+            arena.add(i, NAMES[i], srh::DefaultComparator::INST);
+        arena.finish(std::size(NAMES));
+    }
+
+}   // anon namespace
+
+
+///
+///  All kernels give the same as old findNeedle
+///
+TEST (Matcher, SameAsOld)
+{
+    Hay hay;
+    srh::Cache cache;
+    for (auto kernel : { srh::Kernel::SCALAR, srh::Kernel::SSE2, srh::Kernel::AVX2 }) {
+        if (!srh::isSupported(kernel))
+            continue;
+        for (auto what : NEEDLES) {
+            srh::Needle needle(what);
+            for (srh::HayId id = 0; id < hay.arena.nIds(); ++id) {
+                auto& name = hay.arena.names(id)[0];
+                for (auto hclass : { srh::HaystackClass::SCRIPT, srh::HaystackClass::NONSCRIPT }) {
+                    auto expected = srh::findNeedle(
+                            name.value, needle, hclass, cache, srh::DefaultComparator::INST);
+                    auto actual = srh::findNeedle(
+                            kernel, hay.arena.prepared(name), hay.arena.words(name),
+                            needle, hclass);
+                    EXPECT_TRUE(expected == actual)
+                            << "Kernel " << static_cast<int>(kernel)
+                            << ", needle " << toChar(what)
+                            << ", hay " << toChar(name.value);
+                }
+            }
+        }
+    }
+}
+
+
+///
+///  Localized names: all kernels with classifyFolded give the same
+///  as findNeedle with FoldComparator
+///
+TEST (Matcher, SameAsFolded)
+{
+    constexpr std::u8string_view LOC_NAMES[] {
+        u8"Кириллица", u8"Расширенная кириллица — A", u8"Латиница-1, дополнение",
+    };
+    constexpr std::u8string_view LOC_NEEDLES[] {
+        u8"кир", u8"илл", u8"кириллица", u8"дополн", u8"1", u8"латиница доп", u8"ца",
+    };
+    srh::HayArena arena;
+    for (size_t i = 0; i < std::size(LOC_NAMES); ++i)
+        arena.add(i, LOC_NAMES[i], srh::FoldComparator::INST);
+    arena.finish(std::size(LOC_NAMES));
+
+    srh::Cache cache;
+    for (auto kernel : { srh::Kernel::SCALAR, srh::Kernel::SSE2, srh::Kernel::AVX2 }) {
+        if (!srh::isSupported(kernel))
+            continue;
+        for (auto what : LOC_NEEDLES) {
+            srh::Needle needle(srh::fold(what));
+            for (srh::HayId id = 0; id < arena.nIds(); ++id) {
+                auto& name = arena.names(id)[0];
+                auto expected = srh::findNeedle(
+                        name.value, needle, srh::HaystackClass::SCRIPT, cache,
+                        srh::FoldComparator::INST);
+                auto actual = srh::findNeedle(
+                        kernel, arena.prepared(name), arena.words(name),
+                        needle, srh::HaystackClass::SCRIPT, srh::classifyFolded);
+                EXPECT_TRUE(expected == actual)
+                        << "Kernel " << static_cast<int>(kernel)
+                        << ", needle " << toChar(what)
+                        << ", hay " << toChar(name.value);
+            }
+        }
+    }
+}
+
+
+///
+///  Several needle words at once
+///
+TEST (Matcher, Places)
+{
+    Hay hay;
+    auto& name = hay.arena.names(1)[0];   // LATIN SMALL LETTER A WITH RING ABOVE
+    srh::Needle needle(u8"a lett ing atin zz");
+    srh::Place places[5];
+    srh::findPlaces(srh::bestKernel(), hay.arena.prepared(name), hay.arena.words(name),
+                    needle, srh::HaystackClass::SCRIPT, places);
+    EXPECT_EQ(srh::Place::EXACT,         places[0]);
+    EXPECT_EQ(srh::Place::INITIAL_SRIPT, places[1]);    // LETTER is low-prio in scripts
+    EXPECT_EQ(srh::Place::PARTIAL,       places[2]);
+    EXPECT_EQ(srh::Place::PARTIAL,       places[3]);
+    EXPECT_EQ(srh::Place::NONE,          places[4]);
+}
+
+
+///
+///  Micro-benchmark, run with --gtest_also_run_disabled_tests
+///
+TEST (Matcher, DISABLED_Benchmark)
+{
+    // Pseudo-names: Unicode-like words
+    constexpr std::u8string_view WORDS[] {
+        u8"LATIN", u8"CAPITAL", u8"SMALL", u8"LETTER", u8"WITH", u8"ACUTE",
+        u8"CYRILLIC", u8"GREEK", u8"SIGN", u8"SYMBOL", u8"MATHEMATICAL", u8"BOLD",
+        u8"ITALIC", u8"DIGIT", u8"ARROW", u8"LEFTWARDS", u8"RIGHTWARDS", u8"FACE",
+        u8"CJK", u8"IDEOGRAPH", u8"HANGUL", u8"SYLLABLE", u8"TAMIL", u8"VOWEL",
+    };
+    constexpr size_t N_NAMES = 100'000;
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<size_t> dWord(0, std::size(WORDS) - 1), dLen(2, 6);
+    SafeVector<std::u8string> names;
+    names.reserve(N_NAMES);
+    for (size_t i = 0; i < N_NAMES; ++i) {
+        std::u8string s;
+        for (size_t n = dLen(rng); n > 0; --n) {
+            if (!s.empty())
+                s += ' ';
+            s += WORDS[dWord(rng)];
+        }
+        names.push_back(std::move(s));
+    }
+    srh::HayArena arena;
+    for (size_t i = 0; i < N_NAMES; ++i)
+        arena.add(i, names[i], srh::DefaultComparator::INST);
+    arena.finish(N_NAMES);
+
+    srh::Needle needle(u8"lat let a");
+    using Clock = std::chrono::steady_clock;
+    auto report = [](const char* what, Clock::duration time, unsigned sum) {
+        std::cout << what << ": "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(time).count()
+                  << " us, checksum " << sum << std::endl;
+    };
+
+    // Old: prepare + split every time
+    {   srh::Cache cache;
+        unsigned sum = 0;
+        auto t0 = Clock::now();
+        for (auto& v : names)
+            sum += srh::findNeedle(v, needle, srh::HaystackClass::SCRIPT,
+                                   cache, srh::DefaultComparator::INST).initial;
+        report("Old findNeedle", Clock::now() - t0, sum);
+    }
+    // Old over arena
+    {   unsigned sum = 0;
+        auto t0 = Clock::now();
+        for (srh::HayId id = 0; id < N_NAMES; ++id)
+            sum += srh::findNeedle(arena.words(arena.names(id)[0]), needle,
+                                   srh::HaystackClass::SCRIPT,
+                                   srh::DefaultComparator::INST).initial;
+        report("findNeedle over arena", Clock::now() - t0, sum);
+    }
+    // Kernels
+    for (auto kernel : { srh::Kernel::SCALAR, srh::Kernel::SSE2, srh::Kernel::AVX2 }) {
+        if (!srh::isSupported(kernel))
+            continue;
+        unsigned sum = 0;
+        auto t0 = Clock::now();
+        for (srh::HayId id = 0; id < N_NAMES; ++id) {
+            auto& name = arena.names(id)[0];
+            sum += srh::findNeedle(kernel, arena.prepared(name), arena.words(name),
+                                   needle, srh::HaystackClass::SCRIPT).initial;
+        }
+        static constexpr const char* KERNEL_NAMES[] { "Scalar kernel", "SSE2 kernel", "AVX2 kernel" };
+        report(KERNEL_NAMES[static_cast<int>(kernel)], Clock::now() - t0, sum);
+    }
+}
@@ -0,0 +1,103 @@
+// What we are testing
+#include "UcPack.h"
+
+// STL
+#include <string_view>
+
+// Google test
+#include "gtest/gtest.h"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+    uc::pack::Bytes bytesOf(std::string_view x)
+        { return { reinterpret_cast<const unsigned char*>(x.data()), x.size() }; }
+
+    uc::pack::Builder makeBuilder()
+    {
+        uc::pack::Builder r;
+        r.add(uc::pack::SecId::STRINGS, bytesOf("\x02\x01\x03" "abc\0"sv));
+        return r;
+    }
+
+}   // anon namespace
+
+
+///
+///  Simple hash values, known from FNV reference
+///
+TEST (Pack, HashSum)
+{
+    EXPECT_EQ(0xCBF29CE484222325ull, uc::pack::hashSum({}));
+    EXPECT_EQ(0xAF63DC4C8601EC8Cull, uc::pack::hashSum(bytesOf("a")));
+}
+
+
+///
+///  What’s built is read back
+///
+TEST (Pack, RoundTrip)
+{
+    auto builder = makeBuilder();
+    auto data = builder.build();
+    EXPECT_EQ(0u, data.size() % uc::pack::SEC_ALIGN);
+
+    uc::pack::View view;
+    ASSERT_TRUE(view.open(data, builder.stamp()));
+    auto sec = view.section(uc::pack::SecId::STRINGS);
+    std::string_view s { reinterpret_cast<const char*>(sec.data()), sec.size() };
+    EXPECT_EQ("\x02\x01\x03" "abc\0"sv, s);
+    EXPECT_EQ(0u, (sec.data() - data.data()) % uc::pack::SEC_ALIGN);
+    EXPECT_TRUE(view.verify());
+}
+
+
+///
+///  Pack of other data is not used
+///
+TEST (Pack, BadStamp)
+{
+    auto builder = makeBuilder();
+    auto data = builder.build();
+    uc::pack::View view;
+    EXPECT_FALSE(view.open(data, builder.stamp() + 1));
+    EXPECT_TRUE(view.section(uc::pack::SecId::STRINGS).empty());
+}
+
+
+///
+///  Damaged header and truncated file are not opened
+///
+TEST (Pack, BadHeader)
+{
+    auto builder = makeBuilder();
+    auto data = builder.build();
+    uc::pack::View view;
+
+    auto data1 = data;
+    data1[0] = 'X';
+    EXPECT_FALSE(view.open(data1, builder.stamp()));
+
+    auto data2 = data;
+    data2[sizeof(uc::pack::Header) + offsetof(uc::pack::Section, size)] ^= 1;
+    EXPECT_FALSE(view.open(data2, builder.stamp()));
+
+    auto data3 = data;
+    data3.resize(data3.size() - uc::pack::SEC_ALIGN);
+    EXPECT_FALSE(view.open(data3, builder.stamp()));
+}
+
+
+///
+///  Damaged data is opened (we do not read it at once), but not verified
+///
+TEST (Pack, BadData)
+{
+    auto builder = makeBuilder();
+    auto data = builder.build();
+    data[data.size() - uc::pack::SEC_ALIGN + 1] ^= 1;
+    uc::pack::View view;
+    ASSERT_TRUE(view.open(data, builder.stamp()));
+    EXPECT_FALSE(view.verify());
+}
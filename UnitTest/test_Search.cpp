@@ -1,9 +1,15 @@
 // What we are testing
+#include "Search/bench.h"
 #include "Search/engine.h"
+#include "Search/fold.h"
+#include "Search/pattern.h"
 
 // Google test
 #include "gtest/gtest.h"
 
+// STL
+#include <sstream>
+
 TEST (Classify, Letters)
 {
     EXPECT_EQ (srh::Class::LETTER, srh::classify('A'));
@@ -33,3 +39,198 @@ TEST (Classify, Others)
     EXPECT_EQ (srh::Class::OTHER, srh::classify('`'));
     EXPECT_EQ (srh::Class::OTHER, srh::classify('{'));
 }
+
+
+///
+///  English search: UTF-8 bytes are not letters
+///
+TEST (Classify, Utf8)
+{
+    std::u8string_view s = u8"ж";
+    EXPECT_EQ (srh::Class::OTHER, srh::classify(s[0]));
+    EXPECT_EQ (srh::Class::OTHER, srh::classify(s[1]));
+}
+
+
+///
+///  Folded localized text: UTF-8 bytes are parts of letters, the rest as usual
+///
+TEST (Classify, Folded)
+{
+    std::u8string_view s = u8"ж";
+    EXPECT_EQ (srh::Class::LETTER, srh::classifyFolded(s[0]));
+    EXPECT_EQ (srh::Class::LETTER, srh::classifyFolded(s[1]));
+    EXPECT_EQ (srh::Class::LETTER, srh::classifyFolded('A'));
+    EXPECT_EQ (srh::Class::DIGIT, srh::classifyFolded('4'));
+    EXPECT_EQ (srh::Class::OTHER, srh::classifyFolded('-'));
+}
+
+
+///
+///  Folding: Cyrillic upper case, Latin-1 accents away, the rest as is
+///
+TEST (Fold, Simple)
+{
+    EXPECT_TRUE(srh::fold(u8"Кириллица, ёж") == u8"КИРИЛЛИЦА, ЕЖ");
+    EXPECT_TRUE(srh::fold(u8"ґанок, їжак, єнот") == u8"ҐАНОК, ЇЖАК, ЄНОТ");
+    EXPECT_TRUE(srh::fold(u8"Café Ångström") == u8"CAFE ANGSTROM");
+    EXPECT_TRUE(srh::fold(u8"ӂ ӯ") == u8"Ӂ Ӯ");
+    EXPECT_TRUE(srh::fold(u8"α 漢字 ß") == u8"α 漢字 ß");
+}
+
+
+///
+///  Folded needle over folded haystack
+///
+TEST (Fold, FindNeedle)
+{
+    srh::Needle needle(srh::fold(u8"кирил"));
+    srh::Cache cache;
+    auto prio = srh::findNeedle(u8"Расширенная кириллица — A", needle,
+                    srh::HaystackClass::SCRIPT, cache, srh::FoldComparator::INST);
+    EXPECT_EQ(1, prio.initial);
+
+    srh::Needle needle2(srh::fold(u8"ИЛЛ"));
+    auto prio2 = srh::findNeedle(u8"Кириллица", needle2,
+                    srh::HaystackClass::SCRIPT, cache, srh::FoldComparator::INST);
+    EXPECT_EQ(1, prio2.partial);
+}
+
+
+///
+///  Folded comparator: word start is after ASCII separator only
+///
+TEST (Fold, Comparator)
+{
+    auto& cmp = srh::FoldComparator::INST;
+    EXPECT_EQ(srh::FindStatus::COMPLETE, cmp.find(u8"КИРИЛЛИЦА", u8"КИРИЛЛИЦА"));
+    EXPECT_EQ(srh::FindStatus::INITIAL, cmp.find(u8"КИРИЛЛИЦА", u8"КИР"));
+    EXPECT_EQ(srh::FindStatus::INITIAL, cmp.find(u8"НОВАЯ-КИРИЛЛИЦА", u8"КИР"));
+    EXPECT_EQ(srh::FindStatus::SUBSTR, cmp.find(u8"КИРИЛЛИЦА", u8"ИЛЛ"));
+    EXPECT_EQ(srh::FindStatus::NONE, cmp.find(u8"КИРИЛЛИЦА", u8"ЖУК"));
+}
+
+
+///
+///  English words go as before: after non-ASCII byte is word start
+///
+TEST (Classify, DefaultComparator)
+{
+    auto& cmp = srh::DefaultComparator::INST;
+    EXPECT_EQ(srh::FindStatus::INITIAL, cmp.find(u8"ÉLETTER", u8"LETTER"));
+    EXPECT_EQ(srh::FindStatus::SUBSTR, cmp.find(u8"ALETTER", u8"LETTER"));
+}
+
+
+///
+///  Wildcards: whole name, case-insensitive
+///
+TEST (Pattern, Wildcard)
+{
+    srh::Pattern p;
+    ASSERT_EQ(srh::PatternStatus::OK,
+              p.compile(u8"latin * letter * with hook", srh::PatternSyntax::WILDCARD));
+    EXPECT_TRUE(p.matches(u8"LATIN SMALL LETTER H WITH HOOK"));
+    EXPECT_TRUE(p.matches(u8"LATIN CAPITAL LETTER B WITH HOOK"));
+    EXPECT_FALSE(p.matches(u8"LATIN SMALL LETTER H WITH HOOK ABOVE"));
+    EXPECT_FALSE(p.matches(u8"CYRILLIC SMALL LETTER EN WITH HOOK"));
+
+    ASSERT_EQ(srh::PatternStatus::OK, p.compile(u8"GREEK ?", srh::PatternSyntax::WILDCARD));
+    EXPECT_FALSE(p.matches(u8"GREEK"));
+    EXPECT_TRUE(p.matches(u8"GREEK A"));
+    EXPECT_FALSE(p.matches(u8"GREEK AB"));
+}
+
+
+///
+///  Regex: found anywhere unless anchored
+///
+TEST (Pattern, Regex)
+{
+    srh::Pattern p;
+    ASSERT_EQ(srh::PatternStatus::OK, p.compile(u8"^cjk.*radical", srh::PatternSyntax::REGEX));
+    EXPECT_TRUE(p.matches(u8"CJK RADICAL BONE"));
+    EXPECT_TRUE(p.matches(u8"CJK COMPATIBILITY RADICAL"));
+    EXPECT_FALSE(p.matches(u8"KANGXI RADICAL ONE"));
+
+    ASSERT_EQ(srh::PatternStatus::OK, p.compile(u8"DIGIT (ONE|TWO)$", srh::PatternSyntax::REGEX));
+    EXPECT_TRUE(p.matches(u8"SUPERSCRIPT DIGIT TWO"));
+    EXPECT_FALSE(p.matches(u8"DIGIT THREE"));
+    EXPECT_FALSE(p.matches(u8"DIGIT ONE HUNDRED"));
+
+    ASSERT_EQ(srh::PatternStatus::OK, p.compile(u8"^[a-c]+ [^ ]?x\\.$", srh::PatternSyntax::REGEX));
+    EXPECT_TRUE(p.matches(u8"ABBA X."));
+    EXPECT_TRUE(p.matches(u8"C YX."));
+    EXPECT_FALSE(p.matches(u8"ABBA X,"));
+    EXPECT_FALSE(p.matches(u8"D X."));
+    EXPECT_FALSE(p.matches(u8"ABBA  X."));
+}
+
+
+///
+///  Bad and pathological patterns
+///
+TEST (Pattern, Bad)
+{
+    srh::Pattern p;
+    EXPECT_EQ(srh::PatternStatus::SYNTAX, p.compile(u8"(abc", srh::PatternSyntax::REGEX));
+    EXPECT_FALSE(p.matches(u8"ABC"));
+    EXPECT_EQ(srh::PatternStatus::SYNTAX, p.compile(u8"*abc", srh::PatternSyntax::REGEX));
+    EXPECT_EQ(srh::PatternStatus::SYNTAX, p.compile(u8"a^b", srh::PatternSyntax::REGEX));
+    EXPECT_EQ(srh::PatternStatus::SYNTAX, p.compile(u8"[z-a]", srh::PatternSyntax::REGEX));
+    EXPECT_EQ(srh::PatternStatus::SYNTAX, p.compile(u8"abc\\", srh::PatternSyntax::REGEX));
+    EXPECT_EQ(srh::PatternStatus::SYNTAX,
+              p.compile(std::u8string(200, '(') + std::u8string(200, ')'),
+                        srh::PatternSyntax::REGEX));
+    // Exponential DFA: n-th char from end is A
+    EXPECT_EQ(srh::PatternStatus::TOO_COMPLEX,
+              p.compile(u8"A..............$", srh::PatternSyntax::REGEX));
+    EXPECT_FALSE(p.matches(u8"A"));
+}
+
+
+///
+///  Nearest-rank percentiles
+///
+TEST (Bench, Summarize)
+{
+    SafeVector<srh::BenchSample> samples;
+    for (long long i = 100; i >= 1; --i)
+        samples.push_back({ .ns = i, .nAllocs = 10, .nResults = 5 });
+    auto r = srh::summarize(samples);
+    EXPECT_EQ(100u, r.n);
+    EXPECT_EQ(50, r.p50);
+    EXPECT_EQ(95, r.p95);
+    EXPECT_EQ(99, r.p99);
+    EXPECT_EQ(100, r.max);
+    EXPECT_EQ(10, r.nAllocs);
+    EXPECT_EQ(5u, r.nResults);
+
+    samples[3].nAllocs = -1;
+    EXPECT_EQ(-1, srh::summarize(samples).nAllocs);
+
+    samples.resize(1);
+    r = srh::summarize(samples);
+    EXPECT_EQ(100, r.p50);
+    EXPECT_EQ(100, r.p99);
+}
+
+
+///
+///  JSON line, incl. escaping
+///
+TEST (Bench, Json)
+{
+    srh::BenchSummary x { .n = 3, .p50 = 1500, .p95 = 2000, .p99 = 2999,
+                          .max = 3000, .nAllocs = -1, .nResults = 7 };
+    std::ostringstream os;
+    srh::writeJsonLine(os, "search", "a\"b\\c\n", x);
+    EXPECT_EQ("{\"kind\":\"search\",\"name\":\"a\\\"b\\\\c\\u000A\","
+              "\"n\":3,\"p50_us\":1,\"p95_us\":2,\"p99_us\":2,\"max_us\":3,"
+              "\"allocs\":null,\"results\":7}\n", os.str());
+
+    x.nAllocs = 42;
+    os.str({});
+    srh::writeJsonLine(os, "request", "x", x);
+    EXPECT_NE(std::string::npos, os.str().find("\"allocs\":42,"));
+}
@@ -4,6 +4,12 @@
 // Google test
 #include "gtest/gtest.h"
 
+// STL
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+
 #include "UcCp.h"
 
 
@@ -190,3 +196,262 @@ TEST (DecodeTrie, KissMoreEmoji)
     EXPECT_EQ(9u, r2.index);
     EXPECT_EQ(Emoji::SPAIN, r2.result);
 }
+
+
+namespace {
+
+    template <class R>
+    void expectSame(const SafeVector<srh::Decoded<R>>& expected,
+                    const SafeVector<srh::Decoded<R>>& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i].index, actual[i].index);
+            EXPECT_EQ(expected[i].result, actual[i].result);
+        }
+    }
+
+}   // anon namespace
+
+
+///
+///  Compact trie decodes the same as original
+///
+TEST (DecodeTrie, Compact)
+{
+    Trie1 tr;
+    srh::CompactTrie<Emoji> compact(tr);
+    EXPECT_EQ(21u, compact.nNodes());
+
+    const std::u32string data[] {
+        { cp::FLAG_P, cp::FLAG_R, cp::FLAG_C, cp::FLAG_U, cp::FLAG_E, cp::FLAG_S },
+        { 'A', cp::WOMAN, cp::SKIN1, cp::ZWJ, cp::EMOJI_RED_HEART, cp::VS16, cp::ZWJ,
+               cp::KISS_MARK, cp::ZWJ, cp::MAN, cp::SKIN5, 'B', cp::MAN, cp::SKIN5 },
+        { cp::WOMAN, cp::SKIN1, cp::ZWJ, cp::EMOJI_RED_HEART, cp::VS16, cp::ZWJ,
+               cp::KISS_MARK, cp::ZWJ, cp::MAN, 'A' },
+        { cp::WOMAN, cp::SKIN1, cp::ZWJ, cp::EMOJI_RED_HEART, cp::VS16, cp::ZWJ,
+               cp::KISS_MARK, cp::ZWJ, cp::MAN, cp::FLAG_E, cp::FLAG_S },
+        { 'A', 'B', cp::FLAG_E },
+        {},
+    };
+    for (auto& v : data) {
+        expectSame(tr.decode(v), compact.decode(v));
+    }
+
+    // Find
+    auto root = compact.rootNode();
+    auto p1 = compact.findChild(root, cp::FLAG_E);
+    ASSERT_NE(nullptr, p1);
+    EXPECT_FALSE(p1->isFinal());
+    auto p2 = compact.findChild(p1, cp::FLAG_S);
+    ASSERT_NE(nullptr, p2);
+    EXPECT_TRUE(p2->isFinal());
+    EXPECT_EQ(2u, p2->depth());
+    EXPECT_EQ(Emoji::SPAIN, p2->result());
+    EXPECT_EQ(nullptr, compact.findChild(p1, cp::FLAG_U));
+}
+
+
+///
+///  Sequence that starts inside an unfinished longer one:
+///  original trie backs off and misses it, compact one misses too
+///
+TEST (DecodeTrie, CompactInside)
+{
+    srh::TrieRoot<int> tr;
+    tr.add(U"abcd", 1);
+    tr.add(U"bc", 2);
+    tr.add(U"cx", 3);
+    srh::CompactTrie<int> compact(tr);
+
+    auto res = compact.decode(U"abcxbcd");
+    ASSERT_EQ(1u, res.size());
+    EXPECT_EQ(4u, res[0].index);
+    EXPECT_EQ(2, res[0].result);
+
+    expectSame(tr.decode(U"abcxbcd"), res);
+}
+
+
+///
+///  Streaming decoder: same as decode, and nKnown is honest
+///
+TEST (DecodeTrie, Streaming)
+{
+    srh::TrieRoot<int> tr;
+    tr.add(U"abcd", 1);
+    tr.add(U"bc", 2);
+    tr.add(U"cx", 3);
+    tr.add(U"dd", 4);
+    srh::CompactTrie<int> compact(tr);
+
+    const std::u32string_view data[] {
+        U"abcxbcd", U"abcdddbc", U"xabcdabcd", U"d", U"", U"bcbcbcx" };
+    for (auto text : data) {
+        auto expected = compact.decode(text);
+        srh::CompactTrie<int>::Decoder decoder(compact);
+        SafeVector<srh::Decoded<int>> actual;
+        for (auto c : text) {
+            decoder.feed(c, actual);
+            EXPECT_LE(decoder.nKnown(), decoder.nFed());
+            // Everything that starts before nKnown is out
+            for (auto& v : expected) {
+                if (v.index < decoder.nKnown()) {
+                    EXPECT_TRUE(std::any_of(actual.begin(), actual.end(),
+                            [&v](auto& x) { return x.index == v.index; }));
+                }
+            }
+        }
+        decoder.finish(actual);
+        EXPECT_EQ(text.length(), decoder.nKnown());
+        expectSame(expected, actual);
+    }
+}
+
+
+///
+///  Real emoji from emoji-test.txt, the same set Unicodia decodes:
+///  original trie, compact trie and streaming decoder give the same
+///
+TEST (DecodeTrie, RealEmoji)
+{
+    std::ifstream is(RAWDATA_DIR "emoji-test.txt");
+    if (!is.is_open())
+        GTEST_SKIP() << "No emoji-test.txt";
+
+    // Same filter as AutoBuilder
+    SafeVector<std::u32string> seqs;
+    srh::TrieRoot<int> tr;
+    std::string line;
+    while (std::getline(is, line)) {
+        auto pSemicolon = line.find(';');
+        auto pHash = line.find('#');
+        if (line.empty() || line[0] == '#' || pSemicolon == std::string::npos
+                || pHash < pSemicolon)
+            continue;
+        auto qualType = line.substr(pSemicolon + 1, pHash - pSemicolon - 1);
+        if (qualType.find("fully-qualified") == std::string::npos
+                && qualType.find("component") == std::string::npos)
+            continue;
+        std::u32string seq;
+        size_t pos = 0;
+        while (pos < pSemicolon) {
+            size_t len = 0;
+            auto code = std::stoul(line.substr(pos, pSemicolon - pos), &len, 16);
+            seq += static_cast<char32_t>(code);
+            pos = line.find_first_not_of(' ', pos + len);
+        }
+        if (seq.length() < 2)
+            continue;
+        tr.add(seq, static_cast<int>(seqs.size()));
+        seqs.push_back(std::move(seq));
+    }
+    ASSERT_GT(seqs.size(), 1000u);
+    srh::CompactTrie<int> compact(tr);
+
+    // Whole, truncated, glued together, mixed with ASCII
+    std::mt19937 rng(371);
+    std::uniform_int_distribution<size_t> dSeq(0, seqs.size() - 1);
+    std::uniform_int_distribution<int> dWhat(0, 5);
+    std::uniform_int_distribution<char32_t> dAscii(' ', '~');
+    for (int iText = 0; iText < 200; ++iText) {
+        std::u32string text;
+        for (int iPart = 0; iPart < 30; ++iPart) {
+            auto& seq = seqs[dSeq(rng)];
+            switch (dWhat(rng)) {
+            case 0:
+            case 1:
+                text += seq;
+                break;
+            case 2:
+            case 3:
+                text += seq.substr(0, std::uniform_int_distribution<size_t>(
+                                        1, seq.length() - 1)(rng));
+                break;
+            case 4:
+                text += seq.substr(std::uniform_int_distribution<size_t>(
+                                        1, seq.length() - 1)(rng));
+                break;
+            default:
+                text += dAscii(rng);
+            }
+        }
+        auto expected = tr.decode(text);
+        expectSame(expected, compact.decode(text));
+
+        srh::CompactTrie<int>::Decoder decoder(compact);
+        SafeVector<srh::Decoded<int>> actual;
+        for (auto c : text)
+            decoder.feed(c, actual);
+        decoder.finish(actual);
+        expectSame(expected, actual);
+    }
+}
+
+
+///
+///  Decoding multi-megabyte text, run with --gtest_also_run_disabled_tests
+///
+TEST (DecodeTrie, DISABLED_Benchmark)
+{
+    // Emoji-like: base + modifier, ZWJ sequences, flags
+    constexpr char32_t BASE0 = 0x1F466, N_BASES = 64;
+    constexpr char32_t SKIN0 = cp::SKIN1, N_SKINS = 5;
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<char32_t> dBase(0, N_BASES - 1), dSkin(0, N_SKINS - 1),
+            dFlag(0, 25), dAscii(' ', '~');
+    std::uniform_int_distribution<int> dWhat(0, 9);
+
+    srh::TrieRoot<int> tr;
+    int nSeqs = 0;
+    for (char32_t b = 0; b < N_BASES; ++b) {
+        for (char32_t sk = 0; sk < N_SKINS; ++sk) {
+            tr.addMulti(++nSeqs, BASE0 + b, SKIN0 + sk);
+            tr.addMulti(++nSeqs, BASE0 + b, SKIN0 + sk, cp::ZWJ, BASE0 + (b + 1) % N_BASES);
+        }
+        tr.addMulti(++nSeqs, BASE0 + b, cp::ZWJ, cp::EMOJI_RED_HEART, cp::VS16);
+    }
+    for (char32_t f1 = 0; f1 < 26; ++f1)
+        for (char32_t f2 = 0; f2 < 26; ++f2)
+            tr.addMulti(++nSeqs, cp::FLAG_A + f1, cp::FLAG_A + f2);
+    srh::CompactTrie<int> compact(tr);
+
+    // ≈4M chars of text with emoji
+    std::u32string text;
+    constexpr size_t LENGTH = 4'000'000;
+    text.reserve(LENGTH + 10);
+    while (text.length() < LENGTH) {
+        switch (dWhat(rng)) {
+        case 0:
+            text += BASE0 + dBase(rng);
+            text += SKIN0 + dSkin(rng);
+            break;
+        case 1:
+            text += BASE0 + dBase(rng);
+            text += SKIN0 + dSkin(rng);
+            text += cp::ZWJ;
+            text += BASE0 + dBase(rng);
+            break;
+        case 2:
+            text += cp::FLAG_A + dFlag(rng);
+            text += cp::FLAG_A + dFlag(rng);
+            break;
+        default:
+            text += dAscii(rng);
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto report = [](const char* what, Clock::duration time, size_t n) {
+        std::cout << what << ": "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(time).count()
+                  << " us, " << n << " found" << std::endl;
+    };
+    auto t0 = Clock::now();
+    auto r1 = tr.decode(text);
+    report("Back-off trie", Clock::now() - t0, r1.size());
+    t0 = Clock::now();
+    auto r2 = compact.decode(text);
+    report("Compact trie", Clock::now() - t0, r2.size());
+    expectSame(r1, r2);
+}
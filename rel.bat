@@ -25,12 +25,14 @@
 @set UCSUTTON=UcAutoSutton.cpp
 @set UCSCRIPT=UcAutoScripts.h
 @set UCOLDCOMP=UcAutoOldComp.cpp
+@set UCPACK=UcData.pack
 @set AB_UCAUTO=%BUILD_AB%/%UCAUTO%
 @set AB_UCLIB=%BUILD_AB%/%UCLIB%
 @set AB_UCCOUNT=%BUILD_AB%/%UCCOUNT%
 @set AB_UCSUTTON=%BUILD_AB%/%UCSUTTON%
 @set AB_UCSCRIPT=%BUILD_AB%/%UCSCRIPT%
 @set AB_UCOLDCOMP=%BUILD_AB%/%UCOLDCOMP%
+@set AB_UCPACK=%BUILD_AB%\%UCPACK%
 
 @path %MINGW%;%PATH%
 
@@ -110,6 +112,7 @@
 @if not exist %AB_UCLIB% goto end
 @if not exist %AB_UCCOUNT% goto end
 @if not exist %AB_UCSUTTON% goto end
+@if not exist %AB_UCPACK% goto end
 
 @echo.
 @echo ===== Running SmartCopy =====
@@ -133,6 +136,7 @@
 @echo.
 @echo ===== Copying files =====
 @copy %BUILD%\release\%EXENAME% %DEPLOY%
+@copy %AB_UCPACK% %DEPLOY%
 @copy %MINGW%\libgcc_s_seh-1.dll %DEPLOY%
 @copy "%MINGW%\libstdc++-6.dll" %DEPLOY%
 @copy %MINGW%\libwinpthread-1.dll %DEPLOY%